@@ -5,10 +5,14 @@ from models.follower_check import FollowerAuthenticityChecker
 from models.engagement_check import EngagementQualityChecker
 from models.velocity_check import VelocityChecker
 from models.geo_location_check import GeoLocationChecker
+from models.post_batch import PostBatch
+from models.adaptive_sampler import AdaptiveSampler
 
 __all__ = [
     'FollowerAuthenticityChecker',
     'EngagementQualityChecker',
     'VelocityChecker',
-    'GeoLocationChecker'
+    'GeoLocationChecker',
+    'PostBatch',
+    'AdaptiveSampler'
 ]
\ No newline at end of file
@@ -3,12 +3,16 @@ AI Verifier - Main Service
 Flask API for AI-powered fraud detection
 """
 import logging
-from flask import Flask, request, jsonify
+import time
+from flask import Flask, Response, g, request, jsonify
 from flask_cors import CORS
-from typing import Dict, Any
+from typing import Dict, Any, List
 from data_fetcher import DataFetcher
 from fraud_detector import FraudDetector
+from result_cache import VerificationCache, cache_key
+from engagement_baseline import BaselineStore
 from config import Config
+from metrics import REGISTRY, FETCH_SECONDS, REQUEST_SECONDS, REQUESTS
 
 # Setup logging
 logging.basicConfig(
@@ -23,7 +27,40 @@ CORS(app)
 
 # Initialize services
 data_fetcher = DataFetcher()
-fraud_detector = FraudDetector()
+baselines = BaselineStore(
+    Config.BASELINE['file'], Config.BASELINE['window_days'],
+    Config.BASELINE['min_posts'], Config.BASELINE['flush_every']
+) if Config.BASELINE['enabled'] else None
+fraud_detector = FraudDetector(baselines)
+result_cache = VerificationCache(Config.CACHE['ttl_seconds'], Config.CACHE['max_entries'])
+
+# Cache counters, read from the cache when metrics are scraped
+for _stat in ('hits', 'misses', 'coalesced', 'evictions', 'expirations', 'invalidations'):
+    REGISTRY.counter_callback(f'ai_cache_{_stat}_total', f'Verification cache {_stat}',
+                              lambda stat=_stat: result_cache.stats()[stat])
+REGISTRY.gauge_callback('ai_cache_entries', 'Verification results cached',
+                        lambda: result_cache.stats()['size'])
+REGISTRY.gauge_callback('ai_cache_in_flight', 'Verification results being computed',
+                        lambda: result_cache.stats()['in_flight'])
+
+@app.before_request
+def _start_timer():
+    g.request_started = time.perf_counter()
+
+@app.after_request
+def _record_request(response):
+    """Latency and count per route (the rule, not the raw path, to bound label values)"""
+    endpoint = request.url_rule.rule if request.url_rule else 'unmatched'
+    started = getattr(g, 'request_started', None)
+    if started is not None:
+        REQUEST_SECONDS.labels(endpoint).observe(time.perf_counter() - started)
+    REQUESTS.labels(endpoint, response.status_code).inc()
+    return response
+
+@app.route('/metrics', methods=['GET'])
+def metrics():
+    """Prometheus metrics"""
+    return Response(REGISTRY.render(), mimetype='text/plain; version=0.0.4')
 
 @app.route('/health', methods=['GET'])
 def health_check():
@@ -31,7 +68,10 @@ def health_check():
     return jsonify({
         'status': 'healthy',
         'service': 'AI Verification Service',
-        'version': '1.0.0'
+        'version': '1.0.0',
+        'thresholds_version': Config.THRESHOLDS_VERSION,
+        'cache': result_cache.stats() if Config.CACHE['enabled'] else {'enabled': False},
+        'baselines': baselines.summary() if baselines else {'enabled': False}
     }), 200
 
 @app.route('/verify', methods=['POST'])
@@ -70,15 +110,14 @@ def verify_post():
         logger.info(f"Verification request for: {post_url} (scenario: {scenario})")
         
         # Fetch post data
-        post_data = data_fetcher.fetch_post_data(post_url, scenario)
+        with FETCH_SECONDS.labels('single').time():
+            post_data = data_fetcher.fetch_post_data(post_url, scenario)
         
-        # Run fraud detection
-        result = fraud_detector.detect(post_data)
+        # Run fraud detection (or reuse the result for identical data)
+        result = _detect([post_url], [post_data])[0]
         
         # Add request metadata
-        result['post_url'] = post_url
-        result['scenario'] = scenario
-        result['fetch_timestamp'] = post_data['fetch_timestamp'].isoformat()
+        _add_request_metadata(result, post_url, scenario, post_data)
         
         logger.info(f"Verification complete: Score {result['overall_score']}, "
                    f"Recommendation: {result['recommendation']}")
@@ -92,6 +131,131 @@ def verify_post():
         logger.error(f"Unexpected error: {str(e)}", exc_info=True)
         return jsonify({'error': 'Internal server error'}), 500
 
+@app.route('/verify/batch', methods=['POST'])
+def verify_batch():
+    """
+    Batch verification endpoint
+    Fetches every post concurrently, then scores them in one detector pass
+    
+    Request body:
+    {
+        "requests": [
+            {"post_url": "https://instagram.com/p/xyz", "scenario": "legitimate"},
+            ...
+        ]
+    }
+    
+    Response (results in request order):
+    {
+        "results": [
+            {...same as /verify...},
+            {"post_url": "...", "scenario": "...", "error": "Unknown scenario: ..."}
+        ],
+        "count": 2,
+        "failed": 1
+    }
+    
+    A post that cannot be fetched gets an error entry instead of failing
+    the whole batch; a malformed request body is still a 400.
+    """
+    try:
+        # Validate request
+        data = request.get_json()
+        if not data:
+            return jsonify({'error': 'No JSON data provided'}), 400
+        
+        items = data.get('requests')
+        if not isinstance(items, list) or len(items) == 0:
+            return jsonify({'error': 'requests must be a non-empty list'}), 400
+        
+        max_size = Config.BATCH['max_size']
+        if len(items) > max_size:
+            return jsonify({'error': f'At most {max_size} requests per batch'}), 400
+        
+        posts = []
+        for item in items:
+            if not isinstance(item, dict) or not item.get('post_url'):
+                return jsonify({'error': 'post_url is required for every request'}), 400
+            posts.append((item['post_url'], item.get('scenario', 'legitimate')))
+        
+        logger.info(f"Batch verification request for {len(posts)} posts")
+        
+        # Fetch post data concurrently
+        with FETCH_SECONDS.labels('batch').time():
+            fetched = data_fetcher.fetch_many(posts, Config.BATCH['fetch_workers'])
+        
+        # Run fraud detection over everything that was fetched
+        ready = [(post_url, post_data) for (post_url, _), post_data in zip(posts, fetched)
+                 if not isinstance(post_data, Exception)]
+        scored = _detect([post_url for post_url, _ in ready], [post_data for _, post_data in ready])
+        
+        results: List[Dict[str, Any]] = []
+        scored_iter = iter(scored)
+        for (post_url, scenario), post_data in zip(posts, fetched):
+            if isinstance(post_data, Exception):
+                logger.error(f"Batch item {post_url} failed: {str(post_data)}")
+                results.append({
+                    'post_url': post_url,
+                    'scenario': scenario,
+                    'error': str(post_data) if isinstance(post_data, ValueError) else 'Internal server error'
+                })
+                continue
+            result = next(scored_iter)
+            _add_request_metadata(result, post_url, scenario, post_data)
+            results.append(result)
+        
+        failed = len(posts) - len(ready)
+        logger.info(f"Batch verification complete: {len(ready)} scored, {failed} failed")
+        
+        return jsonify({
+            'results': results,
+            'count': len(results),
+            'failed': failed
+        }), 200
+        
+    except Exception as e:
+        logger.error(f"Unexpected error: {str(e)}", exc_info=True)
+        return jsonify({'error': 'Internal server error'}), 500
+
+def _detect(post_urls: List[str], posts_data: List[Dict[str, Any]]) -> List[Dict[str, Any]]:
+    """
+    Fraud detection through the result cache
+    Results are keyed on (post URL, data snapshot, thresholds version); only
+    posts without a cached or in-flight result are scored, in one batch
+    """
+    if not Config.CACHE['enabled']:
+        return fraud_detector.detect_batch(posts_data)
+    
+    keys = [cache_key(post_url, post_data, Config.THRESHOLDS_VERSION)
+            for post_url, post_data in zip(post_urls, posts_data)]
+    return result_cache.get_or_compute_many(
+        keys,
+        lambda claimed: fraud_detector.detect_batch([posts_data[i] for i in claimed])
+    )
+
+def _add_request_metadata(result: Dict[str, Any], post_url: str, scenario: str,
+                          post_data: Dict[str, Any]) -> None:
+    """Attach the request fields to a detection result"""
+    result['post_url'] = post_url
+    result['scenario'] = scenario
+    result['fetch_timestamp'] = post_data['fetch_timestamp'].isoformat()
+
+@app.route('/cache/invalidate', methods=['POST'])
+def invalidate_cache():
+    """
+    Drop cached verification results
+    
+    Request body (optional):
+    {
+        "post_url": "https://instagram.com/p/xyz"   # Omit to clear everything
+    }
+    """
+    data = request.get_json(silent=True) or {}
+    post_url = data.get('post_url')
+    removed = result_cache.invalidate(post_url)
+    logger.info(f"Cache invalidated for {post_url or 'all posts'}: {removed} entries")
+    return jsonify({'invalidated': removed}), 200
+
 @app.route('/scenarios', methods=['GET'])
 def get_scenarios():
     """Get available test scenarios"""
@@ -2,7 +2,10 @@
 AI Verification Service Configuration
 """
 import os
+import json
+import hashlib
 from typing import Dict, Any
+from pattern_matchers import PhraseMatcher, RegexSetMatcher
 
 class Config:
     """Configuration settings for AI Verification Service"""
@@ -12,6 +15,25 @@ class Config:
     API_PORT = int(os.getenv('API_PORT', 5000))
     DEBUG = os.getenv('DEBUG', 'False').lower() == 'true'
     
+    # Verification Result Cache
+    CACHE = {
+        'enabled': os.getenv('RESULT_CACHE_ENABLED', 'True').lower() == 'true',
+        'ttl_seconds': float(os.getenv('RESULT_CACHE_TTL_SECONDS', 300)),
+        'max_entries': int(os.getenv('RESULT_CACHE_MAX_ENTRIES', 1024))
+    }
+    
+    # Versioned threshold rules (config/ai-thresholds.json)
+    THRESHOLDS_FILE = os.getenv(
+        'AI_THRESHOLDS_FILE',
+        os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..', '..', 'config', 'ai-thresholds.json')
+    )
+    
+    # Batch Verification (/verify/batch)
+    BATCH = {
+        'max_size': int(os.getenv('BATCH_MAX_SIZE', 64)),          # Posts per request
+        'fetch_workers': int(os.getenv('BATCH_FETCH_WORKERS', 8))  # Concurrent DataFetcher calls
+    }
+    
     # AI Verification Thresholds
     THRESHOLDS = {
         'follower_authenticity_min': 85,  # Minimum % of real followers
@@ -42,12 +64,50 @@ class Config:
             '❤️', '🔥', '👍', '😍',
             'check my bio', 'follow me', 'dm me'
         ],
+        'promotional_keywords': [
+            'check my bio', 'follow me', 'dm me', 'link in bio',
+            'click here', 'visit my', 'free followers'
+        ],
+        'generic_comment_patterns': [
+            r'^(nice|cool|awesome|great|amazing|love it|perfect)!*$',
+            r'^(this is|so) (nice|cool|awesome|great|amazing)!*$',
+            r'^love (this|it)!*$'
+        ],
         'velocity_window_hours': 24,
         'suspicious_locations': [
             'Unknown', 'Bot Farm', 'Multiple'
         ]
     }
     
+    # Adaptive follower sampling: checks read followers in chunks and stop once
+    # the confidence interval of their statistic lies outside the borderline
+    # band, so clear-cut posts skip most of the sample
+    SAMPLING = {
+        'enabled': os.getenv('ADAPTIVE_SAMPLING_ENABLED', 'True').lower() == 'true',
+        'follower_sample_size': int(os.getenv('FOLLOWER_SAMPLE_SIZE', 1000)),
+        'geo_sample_size': int(os.getenv('GEO_SAMPLE_SIZE', 500)),
+        'min_sample': 100,        # Followers read before the first stop test
+        'chunk_size': 100,        # Followers read between stop tests
+        'confidence_z': 2.576,    # 99% interval
+        'follower_band': (60, 95),  # Borderline authenticity scores (around follower_authenticity_min)
+        'geo_band': (40, 80)        # Borderline aligned percentages (around geo_alignment_min)
+    }
+    
+    # Streaming engagement baseline: each influencer's velocity mean and
+    # standard deviation over recent posts, replacing the fetched scalar
+    # average once enough posts have been scored
+    BASELINE = {
+        'enabled': os.getenv('ENGAGEMENT_BASELINE_ENABLED', 'True').lower() == 'true',
+        'file': os.getenv(
+            'ENGAGEMENT_BASELINE_FILE',
+            os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'data', 'engagement-baselines.json')
+        ),
+        'window_days': int(os.getenv('ENGAGEMENT_BASELINE_DAYS', 30)),        # historical_data_days
+        'min_posts': int(os.getenv('ENGAGEMENT_BASELINE_MIN_POSTS', 10)),     # velocity_baseline_posts
+        'flush_every': int(os.getenv('ENGAGEMENT_BASELINE_FLUSH_EVERY', 50)), # New posts between file writes
+        'min_relative_std': 0.1   # Std dev floor, as a fraction of the mean
+    }
+    
     # Social Media API Settings (placeholders for real APIs)
     INSTAGRAM_API = {
         'enabled': os.getenv('INSTAGRAM_API_ENABLED', 'False').lower() == 'true',
@@ -66,6 +126,45 @@ class Config:
     LOG_LEVEL = os.getenv('LOG_LEVEL', 'INFO')
     LOG_FORMAT = '%(asctime)s - %(name)s - %(levelname)s - %(message)s'
     
+    # Version of the rules results are computed under, set by load_thresholds_version()
+    THRESHOLDS_VERSION: str = None
+    
+    # Pattern matchers, compiled from FRAUD_DETECTION by compile_matchers()
+    BOT_USERNAME_MATCHER: RegexSetMatcher = None
+    SPAM_PHRASE_MATCHER: PhraseMatcher = None
+    GENERIC_COMMENT_MATCHER: RegexSetMatcher = None
+    
+    @classmethod
+    def compile_matchers(cls) -> None:
+        """
+        Compile each FRAUD_DETECTION pattern list into one matcher
+        Spam phrases and promotional keywords share one Aho-Corasick automaton
+        """
+        settings = cls.FRAUD_DETECTION
+        cls.BOT_USERNAME_MATCHER = RegexSetMatcher(settings['bot_username_patterns'])
+        cls.SPAM_PHRASE_MATCHER = PhraseMatcher(
+            [p.lower() for p in settings['spam_comment_phrases'] + settings['promotional_keywords']]
+        )
+        cls.GENERIC_COMMENT_MATCHER = RegexSetMatcher(settings['generic_comment_patterns'])
+    
+    @classmethod
+    def load_thresholds_version(cls) -> None:
+        """
+        Version results are cached under: the ai-thresholds.json version plus
+        a fingerprint of the settings scoring actually reads, so editing either
+        invalidates cached results
+        """
+        try:
+            with open(cls.THRESHOLDS_FILE) as f:
+                file_version = json.load(f).get('version', 'unversioned')
+        except (OSError, ValueError):
+            file_version = 'unversioned'
+        
+        settings = json.dumps([cls.THRESHOLDS, cls.WEIGHTS, cls.FRAUD_DETECTION, cls.SAMPLING, cls.BASELINE],
+                              sort_keys=True)
+        fingerprint = hashlib.sha256(settings.encode()).hexdigest()[:12]
+        cls.THRESHOLDS_VERSION = f"{file_version}+{fingerprint}"
+    
     @classmethod
     def validate(cls) -> bool:
         """Validate configuration settings"""
@@ -74,5 +173,7 @@ class Config:
             raise ValueError(f"Weights must sum to 1.0, got {weight_sum}")
         return True
 
-# Validate on import
-Config.validate()
\ No newline at end of file
+# Validate and compile matchers on import
+Config.validate()
+Config.compile_matchers()
+Config.load_thresholds_version()
\ No newline at end of file
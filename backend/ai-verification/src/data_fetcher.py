@@ -4,7 +4,8 @@ Simulates fetching real data from social media platforms
 """
 import re
 import random
-from typing import Dict, List, Any, Optional
+from concurrent.futures import ThreadPoolExecutor
+from typing import Dict, List, Any, Optional, Tuple, Union
 from datetime import datetime, timedelta
 import logging
 
@@ -20,6 +21,7 @@ class DataFetcher:
         """Load predefined test scenarios"""
         return {
             'legitimate': {
+                'influencer_id': 'sim_legitimate_creator',
                 'followers': self._generate_legitimate_followers(1000),
                 'engagement': self._generate_legitimate_engagement(100),
                 'historical_avg_engagement': 8.5,
@@ -28,6 +30,7 @@ class DataFetcher:
                 'influencer_language': 'English'
             },
             'bot_fraud': {
+                'influencer_id': 'sim_bot_boosted',
                 'followers': self._generate_bot_followers(1000),
                 'engagement': self._generate_bot_engagement(200),
                 'historical_avg_engagement': 2.1,
@@ -36,6 +39,7 @@ class DataFetcher:
                 'influencer_language': 'English'
             },
             'mixed_quality': {
+                'influencer_id': 'sim_mixed_audience',
                 'followers': self._generate_mixed_followers(1000),
                 'engagement': self._generate_mixed_engagement(150),
                 'historical_avg_engagement': 6.2,
@@ -61,6 +65,25 @@ class DataFetcher:
         
         return data
     
+    def fetch_many(self, posts: List[Tuple[str, str]],
+                   max_workers: int = 8) -> List[Union[Dict[str, Any], Exception]]:
+        """
+        Fetch data for many (post_url, scenario) pairs concurrently
+        Results are in input order; a failed fetch yields its exception
+        instead of aborting the rest
+        """
+        def fetch(post: Tuple[str, str]) -> Union[Dict[str, Any], Exception]:
+            try:
+                return self.fetch_post_data(post[0], post[1])
+            except Exception as e:
+                return e
+        
+        if len(posts) <= 1:
+            return [fetch(post) for post in posts]
+        
+        with ThreadPoolExecutor(max_workers=min(max_workers, len(posts))) as pool:
+            return list(pool.map(fetch, posts))
+    
     def _generate_legitimate_followers(self, count: int) -> List[Dict]:
         """Generate realistic follower profiles"""
         followers = []
@@ -0,0 +1,181 @@
+"""
+Engagement Baseline
+Per-influencer streaming mean and standard deviation of engagement velocity
+"""
+import atexit
+import hashlib
+import json
+import logging
+import os
+import threading
+import time
+from collections import deque
+from datetime import datetime
+from typing import Callable, Deque, Dict, List, NamedTuple, Optional
+
+logger = logging.getLogger(__name__)
+
+_SECONDS_PER_DAY = 86400
+_RECENT_POSTS = 32   # Post keys remembered per influencer, so a re-scored post is not counted twice
+
+class BaselineStats(NamedTuple):
+    posts: int
+    mean: float
+    std_dev: float
+
+def _merge(a: List[float], b: List[float]) -> List[float]:
+    """Combine two Welford states [n, mean, m2] (Chan et al.)"""
+    n = a[0] + b[0]
+    if n == 0:
+        return [0, 0.0, 0.0]
+    delta = b[1] - a[1]
+    mean = a[1] + delta * b[0] / n
+    m2 = a[2] + b[2] + delta * delta * a[0] * b[0] / n
+    return [n, mean, m2]
+
+class InfluencerBaseline:
+    """
+    Velocity samples of one influencer, bucketed by day
+    Each bucket is a Welford state [n, mean, m2], updated in O(1) per post;
+    window statistics merge at most window_days buckets and never revisit
+    individual posts.
+    """
+    __slots__ = ('buckets', 'recent_posts')
+
+    def __init__(self):
+        self.buckets: Dict[int, List[float]] = {}
+        self.recent_posts: Deque[str] = deque(maxlen=_RECENT_POSTS)
+
+    def add(self, day: int, value: float, post_key: str) -> bool:
+        """Add one post's velocity; false if the post was already counted"""
+        if post_key in self.recent_posts:
+            return False
+        self.recent_posts.append(post_key)
+        bucket = self.buckets.setdefault(day, [0, 0.0, 0.0])
+        bucket[0] += 1
+        delta = value - bucket[1]
+        bucket[1] += delta / bucket[0]
+        bucket[2] += delta * (value - bucket[1])
+        return True
+
+    def prune(self, oldest_day: int) -> None:
+        for day in [d for d in self.buckets if d < oldest_day]:
+            del self.buckets[day]
+
+    def stats(self, oldest_day: int) -> BaselineStats:
+        """Mean and sample standard deviation over buckets from oldest_day on"""
+        total = [0, 0.0, 0.0]
+        for day, bucket in self.buckets.items():
+            if day >= oldest_day:
+                total = _merge(total, bucket)
+        n, mean, m2 = total
+        std_dev = (m2 / (n - 1)) ** 0.5 if n > 1 else 0.0
+        return BaselineStats(int(n), mean, std_dev)
+
+    def to_compact(self) -> Dict:
+        return {'d': [[day] + bucket for day, bucket in sorted(self.buckets.items())],
+                'p': list(self.recent_posts)}
+
+    @classmethod
+    def from_compact(cls, data: Dict) -> 'InfluencerBaseline':
+        baseline = cls()
+        baseline.buckets = {int(row[0]): [row[1], row[2], row[3]] for row in data.get('d', [])}
+        baseline.recent_posts.extend(data.get('p', []))
+        return baseline
+
+class BaselineStore:
+    """
+    Thread-safe engagement baselines for all influencers, persisted to a JSON
+    file (written atomically every flush_every new posts and at exit)
+
+    stats() returns None until an influencer has min_posts posts in the
+    window, so callers fall back to the fetched scalar average.
+    """
+
+    def __init__(self, path: Optional[str], window_days: int, min_posts: int,
+                 flush_every: int = 50, clock: Callable[[], float] = time.time):
+        self.path = path
+        self.window_days = window_days
+        self.min_posts = min_posts
+        self.flush_every = flush_every
+        self._clock = clock
+        self._lock = threading.Lock()
+        self._baselines: Dict[str, InfluencerBaseline] = {}
+        self._unflushed = 0
+        self._load()
+        if path:
+            atexit.register(self.flush)
+
+    def stats(self, influencer_id: str) -> Optional[BaselineStats]:
+        with self._lock:
+            baseline = self._baselines.get(influencer_id)
+            if baseline is None:
+                return None
+            stats = baseline.stats(self._oldest_day())
+        return stats if stats.posts >= self.min_posts else None
+
+    def record(self, influencer_id: str, post_url: str, velocity: float, post_timestamp: datetime) -> None:
+        """Add a scored post's engagement velocity to its influencer's baseline"""
+        post_key = hashlib.blake2b(post_url.encode(), digest_size=8).hexdigest()
+        day = int(post_timestamp.timestamp() // _SECONDS_PER_DAY)
+        with self._lock:
+            oldest_day = self._oldest_day()
+            if day < oldest_day:
+                return
+            baseline = self._baselines.setdefault(influencer_id, InfluencerBaseline())
+            baseline.prune(oldest_day)
+            if not baseline.add(day, velocity, post_key):
+                return
+            self._unflushed += 1
+            flush = self._unflushed >= self.flush_every
+        if flush:
+            self.flush()
+
+    def flush(self) -> None:
+        """Write every baseline to the store file (temp file, then rename)"""
+        if not self.path:
+            return
+        with self._lock:
+            oldest_day = self._oldest_day()
+            data = {}
+            for influencer_id, baseline in self._baselines.items():
+                baseline.prune(oldest_day)
+                if baseline.buckets:
+                    data[influencer_id] = baseline.to_compact()
+            self._unflushed = 0
+            encoded = json.dumps({'version': 1, 'window_days': self.window_days, 'influencers': data},
+                                 separators=(',', ':'))
+
+        os.makedirs(os.path.dirname(os.path.abspath(self.path)), exist_ok=True)
+        temp_path = f"{self.path}.tmp"
+        with open(temp_path, 'w') as f:
+            f.write(encoded)
+        os.replace(temp_path, self.path)
+
+    def summary(self) -> Dict:
+        """Counts for /health"""
+        with self._lock:
+            oldest_day = self._oldest_day()
+            ready = sum(1 for b in self._baselines.values()
+                        if b.stats(oldest_day).posts >= self.min_posts)
+            return {
+                'influencers': len(self._baselines),
+                'with_baseline': ready,
+                'window_days': self.window_days,
+                'min_posts': self.min_posts
+            }
+
+    def _oldest_day(self) -> int:
+        return int(self._clock() // _SECONDS_PER_DAY) - self.window_days + 1
+
+    def _load(self) -> None:
+        if not self.path or not os.path.exists(self.path):
+            return
+        try:
+            with open(self.path) as f:
+                data = json.load(f)
+            self._baselines = {influencer_id: InfluencerBaseline.from_compact(entry)
+                               for influencer_id, entry in data.get('influencers', {}).items()}
+            logger.info(f"Loaded engagement baselines for {len(self._baselines)} influencers from {self.path}")
+        except (OSError, ValueError, KeyError, IndexError) as e:
+            logger.error(f"Could not load engagement baselines from {self.path}: {str(e)}")
@@ -3,31 +3,40 @@ Fraud Detector
 Orchestrates all fraud detection checks and produces final verdict
 """
 import logging
-from typing import Dict, Any
+from typing import Dict, Any, List, Optional
 from models.follower_check import FollowerAuthenticityChecker
 from models.engagement_check import EngagementQualityChecker
 from models.velocity_check import VelocityChecker
 from models.geo_location_check import GeoLocationChecker
+from models.post_batch import PostBatch
 from config import Config
+from engagement_baseline import BaselineStore
+from metrics import CHECKER_SECONDS, DETECT_SECONDS, POSTS_SCORED
 
 logger = logging.getLogger(__name__)
 
 class FraudDetector:
     """Main fraud detection orchestrator"""
     
-    def __init__(self):
+    def __init__(self, baselines: Optional[BaselineStore] = None):
         self.follower_checker = FollowerAuthenticityChecker()
         self.engagement_checker = EngagementQualityChecker()
         self.velocity_checker = VelocityChecker()
         self.geo_checker = GeoLocationChecker()
         self.weights = Config.WEIGHTS
         self.pass_threshold = Config.THRESHOLDS['overall_pass_score']
+        self.baselines = baselines  # Per-influencer velocity baselines (None: fetched average only)
     
     def detect(self, post_data: Dict) -> Dict[str, Any]:
         """
         Run all fraud detection checks
         Returns comprehensive fraud analysis
         """
+        POSTS_SCORED.inc()
+        with DETECT_SECONDS.time():
+            return self._detect(post_data)
+    
+    def _detect(self, post_data: Dict) -> Dict[str, Any]:
         logger.info("Starting fraud detection analysis")
         
         # Extract data
@@ -36,12 +45,21 @@ class FraudDetector:
         historical_avg = post_data.get('historical_avg_engagement', 5.0)
         post_timestamp = post_data.get('post_timestamp')
         influencer_location = post_data.get('influencer_location', 'Unknown')
+        influencer_id = post_data.get('influencer_id')
+        baseline = self.baselines.stats(influencer_id) if self.baselines and influencer_id else None
+        
+        # Convert the post data to columns once; every check reads the same batch
+        batch = PostBatch(followers, engagement)
         
         # Run all checks
-        follower_result = self.follower_checker.analyze(followers)
-        engagement_result = self.engagement_checker.analyze(engagement)
-        velocity_result = self.velocity_checker.analyze(engagement, historical_avg, post_timestamp)
-        geo_result = self.geo_checker.analyze(followers, engagement, influencer_location)
+        with CHECKER_SECONDS.labels('follower').time():
+            follower_result = self.follower_checker.analyze_batch(batch)
+        with CHECKER_SECONDS.labels('engagement').time():
+            engagement_result = self.engagement_checker.analyze_batch(batch)
+        with CHECKER_SECONDS.labels('velocity').time():
+            velocity_result = self.velocity_checker.analyze_batch(batch, historical_avg, post_timestamp, baseline)
+        with CHECKER_SECONDS.labels('geo').time():
+            geo_result = self.geo_checker.analyze_batch(batch, influencer_location)
         
         # Calculate weighted overall score
         overall_score = (
@@ -66,6 +84,12 @@ class FraudDetector:
         confidence = self._calculate_confidence(follower_result, engagement_result, 
                                                velocity_result, geo_result)
         
+        # Only posts whose audience and engagement look authentic feed the
+        # baseline, so bought engagement does not become the influencer's norm
+        if self.baselines and influencer_id and self._feeds_baseline(follower_result, engagement_result):
+            self.baselines.record(influencer_id, post_data.get('post_url', ''),
+                                  velocity_result['current_velocity'], post_timestamp)
+        
         logger.info(f"Fraud detection complete: Score {overall_score:.2f}/100, "
                    f"Recommendation: {recommendation}")
         
@@ -102,10 +126,27 @@ class FraudDetector:
                 }
             },
             'fraud_flags': all_flags,
+            'samples_used': {
+                'followers_available': len(followers),
+                'follower_authenticity': follower_result.get('total_analyzed', 0),
+                'geo_alignment': geo_result['sampling']['sampled']
+            },
             'summary': self._generate_summary(overall_score, follower_result, 
                                              engagement_result, velocity_result, geo_result)
         }
     
+    def _feeds_baseline(self, follower_result: Dict, engagement_result: Dict) -> bool:
+        return (follower_result['score'] >= Config.THRESHOLDS['follower_authenticity_min'] and
+                engagement_result['score'] >= Config.THRESHOLDS['engagement_quality_min'])
+    
+    def detect_batch(self, posts_data: List[Dict]) -> List[Dict[str, Any]]:
+        """
+        Run fraud detection over many posts with one set of checkers
+        Returns one result per post, in input order
+        """
+        logger.info(f"Starting batch fraud detection for {len(posts_data)} posts")
+        return [self.detect(post_data) for post_data in posts_data]
+    
     def _get_recommendation(self, score: float, flags: list) -> str:
         """Generate payment recommendation"""
         if score >= self.pass_threshold:
@@ -0,0 +1,207 @@
+"""
+Metrics
+Latency histograms and counters, rendered in the Prometheus text format
+"""
+import math
+import threading
+import time
+from contextlib import contextmanager
+from typing import Callable, Dict, Iterator, List, Sequence, Tuple, Union
+
+# Histogram bucket bounds (seconds): 100us to ~105s in steps of sqrt(2),
+# so any recorded latency is within 41% of its bucket's bound (HDR-style
+# log buckets; a value's bucket is computed, not searched)
+_MIN_BOUND = 0.0001
+_STEPS_PER_DOUBLING = 2
+_BUCKET_COUNT = 41
+BUCKET_BOUNDS = [_MIN_BOUND * 2 ** (i / _STEPS_PER_DOUBLING) for i in range(_BUCKET_COUNT)]
+_LE_LABELS = [f'le="{bound:.6g}"' for bound in BUCKET_BOUNDS] + ['le="+Inf"']
+
+LabelValues = Tuple[str, ...]
+
+def _bucket_index(value: float) -> int:
+    """Index of the first bound >= value (_BUCKET_COUNT for +Inf)"""
+    if value <= _MIN_BOUND:
+        return 0
+    index = math.ceil(_STEPS_PER_DOUBLING * math.log2(value / _MIN_BOUND) - 1e-9)
+    return min(index, _BUCKET_COUNT)
+
+def _format_labels(names: Sequence[str], values: Sequence[str], extra: str = '') -> str:
+    pairs = [f'{name}="{_escape(value)}"' for name, value in zip(names, values)]
+    if extra:
+        pairs.append(extra)
+    return '{' + ','.join(pairs) + '}' if pairs else ''
+
+def _escape(value: str) -> str:
+    return str(value).replace('\\', '\\\\').replace('\n', '\\n').replace('"', '\\"')
+
+def _format_value(value: float) -> str:
+    return repr(float(value)) if isinstance(value, float) else str(value)
+
+class _HistogramChild:
+    """One histogram series: fixed-bound bucket counts, sum and count"""
+
+    def __init__(self, lock: threading.Lock):
+        self._lock = lock
+        self.buckets = [0] * (_BUCKET_COUNT + 1)
+        self.sum = 0.0
+        self.count = 0
+
+    def observe(self, seconds: float) -> None:
+        index = _bucket_index(seconds)
+        with self._lock:
+            self.buckets[index] += 1
+            self.sum += seconds
+            self.count += 1
+
+    @contextmanager
+    def time(self) -> Iterator[None]:
+        """Observe the duration of a with block"""
+        started = time.perf_counter()
+        try:
+            yield
+        finally:
+            self.observe(time.perf_counter() - started)
+
+class _CounterChild:
+    def __init__(self, lock: threading.Lock):
+        self._lock = lock
+        self.value = 0
+
+    def inc(self, amount: float = 1) -> None:
+        with self._lock:
+            self.value += amount
+
+class _Family:
+    """A metric name with one child per label value combination"""
+
+    def __init__(self, name: str, help_text: str, label_names: Sequence[str], kind: str, child_type):
+        self.name = name
+        self.help = help_text
+        self.label_names = tuple(label_names)
+        self.kind = kind
+        self._child_type = child_type
+        self._lock = threading.Lock()
+        self._children: Dict[LabelValues, object] = {}
+
+    def labels(self, *values: str):
+        """The series for these label values (created on first use)"""
+        key = tuple(str(v) for v in values)
+        if len(key) != len(self.label_names):
+            raise ValueError(f'{self.name} takes labels {self.label_names}, got {key}')
+        child = self._children.get(key)
+        if child is None:
+            with self._lock:
+                child = self._children.setdefault(key, self._child_type(self._lock))
+        return child
+
+    def children(self) -> List[Tuple[LabelValues, object]]:
+        with self._lock:
+            return list(self._children.items())
+
+class Histogram(_Family):
+    def __init__(self, name: str, help_text: str, label_names: Sequence[str] = ()):
+        super().__init__(name, help_text, label_names, 'histogram', _HistogramChild)
+
+    def observe(self, seconds: float) -> None:
+        """Observe on the unlabeled series"""
+        self.labels().observe(seconds)
+
+    def time(self):
+        """Time a with block on the unlabeled series"""
+        return self.labels().time()
+
+    def render(self) -> List[str]:
+        lines = []
+        for values, child in self.children():
+            with self._lock:
+                buckets = list(child.buckets)
+                total, count = child.sum, child.count
+            cumulative = 0
+            for le, bucket_count in zip(_LE_LABELS, buckets):
+                cumulative += bucket_count
+                lines.append(f'{self.name}_bucket{_format_labels(self.label_names, values, le)} {cumulative}')
+            lines.append(f'{self.name}_sum{_format_labels(self.label_names, values)} {_format_value(total)}')
+            lines.append(f'{self.name}_count{_format_labels(self.label_names, values)} {count}')
+        return lines
+
+class Counter(_Family):
+    def __init__(self, name: str, help_text: str, label_names: Sequence[str] = ()):
+        super().__init__(name, help_text, label_names, 'counter', _CounterChild)
+
+    def inc(self, amount: float = 1) -> None:
+        """Increment the unlabeled series"""
+        self.labels().inc(amount)
+
+    def render(self) -> List[str]:
+        return [f'{self.name}{_format_labels(self.label_names, values)} {_format_value(child.value)}'
+                for values, child in self.children()]
+
+Sample = Union[float, List[Tuple[LabelValues, float]]]
+
+class CallbackMetric:
+    """Gauge or counter whose value is read when metrics are rendered"""
+
+    def __init__(self, name: str, help_text: str, kind: str, read: Callable[[], Sample],
+                 label_names: Sequence[str] = ()):
+        self.name = name
+        self.help = help_text
+        self.kind = kind
+        self.label_names = tuple(label_names)
+        self._read = read
+
+    def render(self) -> List[str]:
+        sample = self._read()
+        if not isinstance(sample, list):
+            return [f'{self.name} {_format_value(sample)}']
+        return [f'{self.name}{_format_labels(self.label_names, values)} {_format_value(value)}'
+                for values, value in sample]
+
+class MetricsRegistry:
+    """The metrics a service exposes on /metrics"""
+
+    def __init__(self):
+        self._metrics: List[object] = []
+
+    def histogram(self, name: str, help_text: str, label_names: Sequence[str] = ()) -> Histogram:
+        return self._add(Histogram(name, help_text, label_names))
+
+    def counter(self, name: str, help_text: str, label_names: Sequence[str] = ()) -> Counter:
+        return self._add(Counter(name, help_text, label_names))
+
+    def gauge_callback(self, name: str, help_text: str, read: Callable[[], Sample],
+                       label_names: Sequence[str] = ()) -> CallbackMetric:
+        return self._add(CallbackMetric(name, help_text, 'gauge', read, label_names))
+
+    def counter_callback(self, name: str, help_text: str, read: Callable[[], Sample],
+                         label_names: Sequence[str] = ()) -> CallbackMetric:
+        return self._add(CallbackMetric(name, help_text, 'counter', read, label_names))
+
+    def render(self) -> str:
+        """Prometheus text exposition format (version 0.0.4)"""
+        lines = []
+        for metric in self._metrics:
+            lines.append(f'# HELP {metric.name} {metric.help}')
+            lines.append(f'# TYPE {metric.name} {metric.kind}')
+            lines.extend(metric.render())
+        return '\n'.join(lines) + '\n'
+
+    def _add(self, metric):
+        self._metrics.append(metric)
+        return metric
+
+# Registry and metrics shared by the service's modules
+REGISTRY = MetricsRegistry()
+
+CHECKER_SECONDS = REGISTRY.histogram(
+    'ai_checker_duration_seconds', 'Time spent in one fraud check for one post', ['checker'])
+DETECT_SECONDS = REGISTRY.histogram(
+    'ai_detect_duration_seconds', 'Time to score one post (all checks)')
+FETCH_SECONDS = REGISTRY.histogram(
+    'ai_fetch_duration_seconds', 'Time to fetch post data for one request', ['mode'])
+REQUEST_SECONDS = REGISTRY.histogram(
+    'ai_request_duration_seconds', 'HTTP request latency', ['endpoint'])
+REQUESTS = REGISTRY.counter(
+    'ai_requests_total', 'HTTP requests served', ['endpoint', 'status'])
+POSTS_SCORED = REGISTRY.counter(
+    'ai_posts_scored_total', 'Posts run through fraud detection (cache misses)')
@@ -0,0 +1,83 @@
+"""
+Adaptive Sampler
+Decides how many followers a check needs to analyze
+"""
+import math
+from typing import Any, Dict, Iterator, Tuple
+from config import Config
+
+def wilson_interval(mean: float, n: int, z: float) -> Tuple[float, float]:
+    """
+    Wilson score interval for a mean of per-follower values in [0, 1]
+    (conservative for non-binary values, whose variance is at most mean * (1 - mean))
+    """
+    if n == 0:
+        return 0.0, 1.0
+    z2 = z * z
+    denominator = 1 + z2 / n
+    center = (mean + z2 / (2 * n)) / denominator
+    half_width = z * math.sqrt(mean * (1 - mean) / n + z2 / (4 * n * n)) / denominator
+    return max(0.0, center - half_width), min(1.0, center + half_width)
+
+class AdaptiveSampler:
+    """
+    Streams a check through the follower list in chunks and stops as soon as
+    the confidence interval of its statistic (a percentage) lies entirely
+    outside the borderline band: the verdict cannot change with more data.
+    Borderline posts keep sampling up to max_sample.
+
+    The follower list is treated as a random sample of the audience, which
+    the fetcher's data is; followers sorted by some attribute would bias the
+    early stop.
+    """
+
+    def __init__(self, band: Tuple[float, float], max_sample: int):
+        settings = Config.SAMPLING
+        self.enabled = settings['enabled']
+        self.band = band
+        self.max_sample = max_sample
+        self.chunk_size = settings['chunk_size']
+        self.min_sample = settings['min_sample']
+        self.z = settings['confidence_z']
+        self.interval: Tuple[float, float] = (0.0, 100.0)
+        self.stopped_early = False
+
+    def chunk_ends(self, available: int) -> Iterator[int]:
+        """
+        End index of each chunk to analyze, in order
+        Without adaptive sampling, the whole list as one chunk
+        """
+        if not self.enabled:
+            if available:
+                yield available
+            return
+
+        limit = min(available, self.max_sample)
+        end = min(limit, self.min_sample)
+        while end > 0:
+            yield end
+            if end >= limit:
+                return
+            end = min(limit, end + self.chunk_size)
+
+    def decided(self, percentage: float, n: int) -> bool:
+        """Record the interval after n followers; true if sampling can stop"""
+        if not self.enabled:
+            return False
+        low, high = wilson_interval(percentage / 100, n, self.z)
+        self.interval = (low * 100, high * 100)
+        self.stopped_early = self.interval[1] < self.band[0] or self.interval[0] > self.band[1]
+        return self.stopped_early
+
+    def report(self, sampled: int, available: int) -> Dict[str, Any]:
+        """Sampling summary for the check's details"""
+        report = {
+            'adaptive': self.enabled,
+            'sampled': sampled,
+            'available': available,
+            'stopped_early': self.stopped_early and sampled < min(available, self.max_sample)
+        }
+        if self.enabled:
+            report['confidence_interval'] = [round(self.interval[0], 2), round(self.interval[1], 2)]
+            report['band'] = list(self.band)
+        return report
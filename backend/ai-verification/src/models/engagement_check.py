@@ -7,6 +7,7 @@ import logging
 from typing import Dict, List, Any
 from collections import Counter
 from config import Config
+from models.post_batch import PostBatch, MISSING
 
 logger = logging.getLogger(__name__)
 
@@ -14,16 +15,22 @@ class EngagementQualityChecker:
     """Analyzes engagement for spam and bot activity"""
     
     def __init__(self):
-        self.spam_phrases = [p.lower() for p in Config.FRAUD_DETECTION['spam_comment_phrases']]
+        self.spam_matcher = Config.SPAM_PHRASE_MATCHER
+        self.generic_matcher = Config.GENERIC_COMMENT_MATCHER
     
     def analyze(self, engagement: Dict) -> Dict[str, Any]:
         """
         Analyze engagement quality
         Returns score and detailed breakdown
         """
-        comments = engagement.get('comments', [])
-        
-        if not comments:
+        return self.analyze_batch(PostBatch(engagement=engagement))
+    
+    def analyze_batch(self, batch: PostBatch) -> Dict[str, Any]:
+        """
+        Analyze the comment columns of a post batch
+        Each distinct comment text is classified once and weighted by its count
+        """
+        if not batch.comment_total:
             return {
                 'score': 50,  # Neutral score if no comments
                 'authentic_count': 0,
@@ -33,26 +40,28 @@ class EngagementQualityChecker:
                 'flags': ['No comments to analyze']
             }
         
-        total = len(comments)
+        total = batch.comment_total
         spam_count = 0
         generic_count = 0
-        duplicate_count = 0
-        
-        comment_texts = [c.get('text', '').lower() for c in comments]
-        duplicates = self._find_duplicates(comment_texts)
-        duplicate_count = sum(duplicates.values())
         
-        flags = []
-        
-        for comment in comments:
-            text = comment.get('text', '').lower().strip()
+        # Duplicates are counted on lowercased text, so distinct texts that
+        # differ only in case fold together
+        lowered_counts = Counter()
+        for code, count in Counter(batch.comment_text).items():
+            text = batch.texts[code].lower()
+            lowered_counts[text] += count
             
+            text = text.strip()
             # Check for spam
             if self._is_spam(text):
-                spam_count += 1
+                spam_count += count
             # Check for generic
             elif self._is_generic(text):
-                generic_count += 1
+                generic_count += count
+        
+        duplicate_count = sum(count - 1 for count in lowered_counts.values() if count > 1)
+        
+        flags = []
         
         authentic_count = total - spam_count - generic_count
         quality_percentage = (authentic_count / total) * 100
@@ -73,7 +82,7 @@ class EngagementQualityChecker:
             flags.append(f'Many generic comments: {generic_count} ({(generic_count/total)*100:.1f}%)')
         
         # Check for bot comment patterns
-        bot_pattern_flags = self._check_bot_patterns(comments)
+        bot_pattern_flags = self._check_bot_patterns(batch)
         flags.extend(bot_pattern_flags)
         
         weighted_score = max(0, min(100, weighted_score))
@@ -93,14 +102,8 @@ class EngagementQualityChecker:
     
     def _is_spam(self, text: str) -> bool:
         """Check if comment is spam"""
-        # Check for exact spam phrases
-        if any(phrase in text for phrase in self.spam_phrases):
-            return True
-        
-        # Check for promotional content
-        spam_keywords = ['check my bio', 'follow me', 'dm me', 'link in bio', 
-                        'click here', 'visit my', 'free followers']
-        if any(keyword in text for keyword in spam_keywords):
+        # Check for spam phrases and promotional content (one scan)
+        if self.spam_matcher.contains(text):
             return True
         
         # Check for only emojis (3+ emojis, no words)
@@ -123,55 +126,36 @@ class EngagementQualityChecker:
             return True
         
         # Generic positive phrases
-        generic_patterns = [
-            r'^(nice|cool|awesome|great|amazing|love it|perfect)!*$',
-            r'^(this is|so) (nice|cool|awesome|great|amazing)!*$',
-            r'^love (this|it)!*$'
-        ]
-        
-        if any(re.match(pattern, text) for pattern in generic_patterns):
-            return True
-        
-        return False
-    
-    def _find_duplicates(self, comment_texts: List[str]) -> Counter:
-        """Find duplicate comments"""
-        counter = Counter(comment_texts)
-        return Counter({text: count - 1 for text, count in counter.items() if count > 1})
+        return self.generic_matcher.matches(text)
     
-    def _check_bot_patterns(self, comments: List[Dict]) -> List[str]:
+    def _check_bot_patterns(self, batch: PostBatch) -> List[str]:
         """Check for bot activity patterns"""
         flags = []
         
-        if not comments:
+        if not batch.comment_total:
             return flags
         
         # Check for rapid-fire comments from same users
-        user_comments = {}
-        for comment in comments:
-            username = comment.get('username', '')
-            if username not in user_comments:
-                user_comments[username] = []
-            user_comments[username].append(comment)
+        user_comments = Counter(batch.comment_username)
         
         # Flag users with multiple comments
-        multi_commenters = sum(1 for user, cmts in user_comments.items() if len(cmts) > 2)
+        multi_commenters = sum(1 for count in user_comments.values() if count > 2)
         if multi_commenters > len(user_comments) * 0.1:
             flags.append(f'{multi_commenters} users posted multiple comments (bot behavior)')
         
         # Check for suspicious usernames in comments
         bot_username_pattern = re.compile(r'^user\d{5,}$')
-        bot_commenters = sum(1 for c in comments if bot_username_pattern.match(c.get('username', '')))
-        if bot_commenters > len(comments) * 0.2:
+        bot_commenters = sum(count for code, count in user_comments.items()
+                             if bot_username_pattern.match(batch.usernames[code]))
+        if bot_commenters > batch.comment_total * 0.2:
             flags.append(f'{bot_commenters} comments from bot-like usernames')
         
         # Check for timing patterns (all within short window)
-        if len(comments) >= 10:
-            timestamps = [c.get('timestamp') for c in comments if c.get('timestamp')]
+        if batch.comment_total >= 10:
+            timestamps = [t for t in batch.comment_timestamp if t is not MISSING and t]
             if timestamps:
-                timestamps.sort()
-                time_span = (timestamps[-1] - timestamps[0]).total_seconds() / 60
-                if time_span < 5 and len(comments) > 20:
-                    flags.append(f'Suspicious timing: {len(comments)} comments in {time_span:.1f} minutes')
+                time_span = (max(timestamps) - min(timestamps)).total_seconds() / 60
+                if time_span < 5 and batch.comment_total > 20:
+                    flags.append(f'Suspicious timing: {batch.comment_total} comments in {time_span:.1f} minutes')
         
-        return flags
\ No newline at end of file
+        return flags
@@ -2,10 +2,11 @@
 Follower Authenticity Check
 Detects fake followers and bot accounts
 """
-import re
 import logging
 from typing import Dict, List, Any
 from config import Config
+from models.post_batch import PostBatch
+from models.adaptive_sampler import AdaptiveSampler
 
 logger = logging.getLogger(__name__)
 
@@ -13,14 +14,23 @@ class FollowerAuthenticityChecker:
     """Analyzes followers for bot signals"""
     
     def __init__(self):
-        self.bot_patterns = [re.compile(p) for p in Config.FRAUD_DETECTION['bot_username_patterns']]
+        self.bot_username_matcher = Config.BOT_USERNAME_MATCHER
     
     def analyze(self, followers: List[Dict]) -> Dict[str, Any]:
         """
         Analyze follower list for authenticity
         Returns score and detailed breakdown
         """
-        if not followers:
+        return self.analyze_batch(PostBatch(followers))
+    
+    def analyze_batch(self, batch: PostBatch) -> Dict[str, Any]:
+        """
+        Analyze the follower columns of a post batch
+        Followers are read in chunks until the score's confidence interval
+        leaves the borderline band (see AdaptiveSampler); username and location
+        signals are evaluated once per distinct value
+        """
+        if not batch.follower_available:
             return {
                 'score': 0,
                 'real_count': 0,
@@ -29,17 +39,78 @@ class FollowerAuthenticityChecker:
                 'flags': ['No followers to analyze']
             }
         
-        total = len(followers)
+        sampler = AdaptiveSampler(Config.SAMPLING['follower_band'], Config.SAMPLING['follower_sample_size'])
+        total = 0
         bot_count = 0
         suspicious_count = 0
         flags = []
         
-        for follower in followers:
-            bot_signals = self._check_bot_signals(follower)
-            if bot_signals['is_definite_bot']:
-                bot_count += 1
-            elif bot_signals['is_suspicious']:
-                suspicious_count += 1
+        # Per distinct value: bot username pattern, suspicious location
+        bot_usernames: List[bool] = []
+        bad_locations: List[bool] = []
+        suspicious_locations = Config.FRAUD_DETECTION['suspicious_locations']
+        
+        for end in sampler.chunk_ends(batch.follower_available):
+            batch.load_followers(end)
+            bot_usernames.extend(self.bot_username_matcher.matches(username)
+                                 for username in batch.usernames[len(bot_usernames):])
+            bad_locations.extend(batch.location_value(code, '') in suspicious_locations
+                                 for code in range(len(bad_locations), len(batch.locations)))
+            
+            for username, has_pic, post_count, following, followers_count, age_days, bio_length, location in zip(
+                    batch.follower_username[total:end], batch.follower_has_profile_pic[total:end],
+                    batch.follower_post_count[total:end], batch.follower_following[total:end],
+                    batch.follower_followers[total:end], batch.follower_account_age[total:end],
+                    batch.follower_bio_length[total:end], batch.follower_location[total:end]):
+                is_definite_bot = False
+                is_suspicious = False
+                reasons = 0
+                
+                # Check 1: Bot username pattern
+                if bot_usernames[username]:
+                    reasons += 1
+                    is_definite_bot = True
+                
+                # Check 2: No profile picture
+                if not has_pic:
+                    reasons += 1
+                    is_suspicious = True
+                
+                # Check 3: Zero posts
+                if post_count == 0:
+                    reasons += 1
+                    is_definite_bot = True
+                
+                # Check 4: Following/Follower ratio (following 10x more than followers)
+                if following > 0 and followers_count > 0 and following / followers_count > 10:
+                    reasons += 1
+                    is_suspicious = True
+                
+                # Check 5: New account with high activity
+                if age_days < 30 and following > 1000:
+                    reasons += 1
+                    is_suspicious = True
+                
+                # Check 6: No bio
+                if bio_length == 0:
+                    reasons += 1
+                    is_suspicious = True
+                
+                # Check 7: Suspicious location
+                if bad_locations[location]:
+                    reasons += 1
+                    is_definite_bot = True
+                
+                # If multiple suspicious signals, upgrade to definite bot
+                if is_definite_bot or reasons >= 3:
+                    bot_count += 1
+                elif is_suspicious:
+                    suspicious_count += 1
+            
+            total = end
+            real_count = total - bot_count - suspicious_count
+            if sampler.decided(((real_count + (suspicious_count * 0.5)) / total) * 100, total):
+                break
         
         real_count = total - bot_count - suspicious_count
         authenticity_percentage = (real_count / total) * 100
@@ -53,7 +124,8 @@ class FollowerAuthenticityChecker:
         if suspicious_count > total * 0.2:
             flags.append(f'Many suspicious accounts: {suspicious_count} ({(suspicious_count/total)*100:.1f}%)')
         
-        logger.info(f"Follower analysis: {real_count} real, {suspicious_count} suspicious, {bot_count} bots")
+        logger.info(f"Follower analysis: {real_count} real, {suspicious_count} suspicious, {bot_count} bots "
+                   f"({total}/{batch.follower_available} sampled)")
         
         return {
             'score': round(weighted_score, 2),
@@ -62,62 +134,6 @@ class FollowerAuthenticityChecker:
             'suspicious_count': suspicious_count,
             'total_analyzed': total,
             'authenticity_percentage': round(authenticity_percentage, 2),
+            'sampling': sampler.report(total, batch.follower_available),
             'flags': flags
         }
-    
-    def _check_bot_signals(self, follower: Dict) -> Dict[str, bool]:
-        """Check individual follower for bot signals"""
-        signals = {
-            'is_definite_bot': False,
-            'is_suspicious': False,
-            'reasons': []
-        }
-        
-        username = follower.get('username', '')
-        
-        # Check 1: Bot username pattern
-        if any(pattern.match(username) for pattern in self.bot_patterns):
-            signals['reasons'].append('Bot username pattern')
-            signals['is_definite_bot'] = True
-        
-        # Check 2: No profile picture
-        if not follower.get('has_profile_pic', True):
-            signals['reasons'].append('No profile picture')
-            signals['is_suspicious'] = True
-        
-        # Check 3: Zero posts
-        if follower.get('post_count', 1) == 0:
-            signals['reasons'].append('Zero posts')
-            signals['is_definite_bot'] = True
-        
-        # Check 4: Following/Follower ratio
-        following = follower.get('following_count', 0)
-        followers_count = follower.get('follower_count', 1)
-        if following > 0 and followers_count > 0:
-            ratio = following / followers_count
-            if ratio > 10:  # Following 10x more than followers
-                signals['reasons'].append('Suspicious follow ratio')
-                signals['is_suspicious'] = True
-        
-        # Check 5: New account with high activity
-        age_days = follower.get('account_age_days', 1000)
-        if age_days < 30 and following > 1000:
-            signals['reasons'].append('New account, high following')
-            signals['is_suspicious'] = True
-        
-        # Check 6: No bio
-        if follower.get('bio_length', 1) == 0:
-            signals['reasons'].append('No bio')
-            signals['is_suspicious'] = True
-        
-        # Check 7: Suspicious location
-        location = follower.get('location', '')
-        if location in Config.FRAUD_DETECTION['suspicious_locations']:
-            signals['reasons'].append('Suspicious location')
-            signals['is_definite_bot'] = True
-        
-        # If multiple suspicious signals, upgrade to definite bot
-        if len(signals['reasons']) >= 3:
-            signals['is_definite_bot'] = True
-        
-        return signals
\ No newline at end of file
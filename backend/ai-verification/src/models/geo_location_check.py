@@ -6,6 +6,8 @@ import logging
 from typing import Dict, List, Any
 from collections import Counter
 from config import Config
+from models.post_batch import PostBatch
+from models.adaptive_sampler import AdaptiveSampler
 
 logger = logging.getLogger(__name__)
 
@@ -31,27 +33,46 @@ class GeoLocationChecker:
         Analyze geographic alignment
         Check if engagement comes from expected regions
         """
-        # Analyze follower locations
-        follower_locations = [f.get('location', 'Unknown') for f in followers]
-        follower_location_counts = Counter(follower_locations)
-        
-        # Analyze engagement locations
-        comments = engagement.get('comments', [])
-        engagement_locations = [c.get('location', 'Unknown') for c in comments]
-        engagement_location_counts = Counter(engagement_locations)
+        return self.analyze_batch(PostBatch(followers, engagement), influencer_location)
+    
+    def analyze_batch(self, batch: PostBatch, influencer_location: str) -> Dict[str, Any]:
+        """
+        Analyze the location columns of a post batch
+        Locations are counted by code, then checked once per distinct location.
+        Followers are read in chunks until the confidence interval of the
+        aligned percentage leaves the borderline band (see AdaptiveSampler).
+        """
+        comment_total = batch.comment_total
         
         # Get expected regions for this influencer
         expected = self.expected_regions.get(influencer_location, [influencer_location])
         
+        # Analyze follower locations
+        sampler = AdaptiveSampler(Config.SAMPLING['geo_band'], Config.SAMPLING['geo_sample_size'])
+        follower_codes = Counter()
+        follower_total = 0
+        for end in sampler.chunk_ends(batch.follower_available):
+            batch.load_followers(end)
+            follower_codes.update(batch.follower_location[follower_total:end])
+            follower_total = end
+            aligned = sum(count for code, count in follower_codes.items()
+                          if batch.location_value(code, 'Unknown') in expected)
+            if sampler.decided((aligned / follower_total) * 100, follower_total):
+                break
+        follower_location_counts = batch.location_names(follower_codes, 'Unknown')
+        
+        # Analyze engagement locations
+        engagement_location_counts = batch.location_counts(batch.comment_location, 'Unknown')
+        
         flags = []
         
         # Calculate alignment scores
         follower_alignment = self._calculate_alignment(
-            follower_location_counts, expected, len(followers)
+            follower_location_counts, expected, follower_total
         )
         
         engagement_alignment = self._calculate_alignment(
-            engagement_location_counts, expected, len(comments)
+            engagement_location_counts, expected, comment_total
         )
         
         # Check for bot farm locations
@@ -65,11 +86,11 @@ class GeoLocationChecker:
         )
         
         # Flags
-        if bot_farm_followers > len(followers) * 0.2:
-            flags.append(f'High bot farm follower presence: {(bot_farm_followers/len(followers)*100):.1f}%')
+        if bot_farm_followers > follower_total * 0.2:
+            flags.append(f'High bot farm follower presence: {(bot_farm_followers/follower_total*100):.1f}%')
         
-        if bot_farm_engagement > len(comments) * 0.2:
-            flags.append(f'High bot farm engagement: {(bot_farm_engagement/len(comments)*100):.1f}%')
+        if bot_farm_engagement > comment_total * 0.2:
+            flags.append(f'High bot farm engagement: {(bot_farm_engagement/comment_total*100):.1f}%')
         
         if follower_alignment['percentage'] < 50:
             flags.append(f'Poor follower location alignment: only {follower_alignment["percentage"]:.1f}% from target regions')
@@ -79,15 +100,15 @@ class GeoLocationChecker:
         
         # Check for suspicious concentration in single non-target country
         top_follower_location = follower_location_counts.most_common(1)[0] if follower_location_counts else ('Unknown', 0)
-        if top_follower_location[0] not in expected and top_follower_location[1] > len(followers) * 0.5:
-            flags.append(f'Suspicious concentration: {top_follower_location[1]} followers ({(top_follower_location[1]/len(followers)*100):.1f}%) from {top_follower_location[0]}')
+        if top_follower_location[0] not in expected and top_follower_location[1] > follower_total * 0.5:
+            flags.append(f'Suspicious concentration: {top_follower_location[1]} followers ({(top_follower_location[1]/follower_total*100):.1f}%) from {top_follower_location[0]}')
         
         # Calculate overall score
         # Weight follower alignment 60%, engagement alignment 40%
         overall_score = (follower_alignment['score'] * 0.6) + (engagement_alignment['score'] * 0.4)
         
         # Penalty for bot farms
-        bot_farm_penalty = min(30, (bot_farm_followers + bot_farm_engagement) / (len(followers) + len(comments)) * 100)
+        bot_farm_penalty = min(30, (bot_farm_followers + bot_farm_engagement) / (follower_total + comment_total) * 100)
         overall_score = max(0, overall_score - bot_farm_penalty)
         
         logger.info(f"Geo analysis: Follower {follower_alignment['percentage']:.1f}% aligned, "
@@ -103,6 +124,7 @@ class GeoLocationChecker:
             'top_engagement_countries': dict(engagement_location_counts.most_common(5)),
             'influencer_location': influencer_location,
             'expected_regions': expected,
+            'sampling': sampler.report(follower_total, batch.follower_available),
             'flags': flags
         }
     
@@ -0,0 +1,107 @@
+"""
+Post Batch
+Columnar view of a post's followers and engagement, shared by all checks
+"""
+from collections import Counter
+from itertools import islice
+from typing import Dict, List, Any, Optional
+
+# Stands in for a key that is absent from the source dict, so each check can
+# apply its own default (the checks do not all default the same way)
+MISSING = object()
+
+class PostBatch:
+    """
+    Walks the follower and comment dicts once and stores each field as a column
+
+    Usernames, locations and comment texts are interned into shared tables,
+    and their columns hold integer codes. A check classifies each distinct value
+    once and counts codes with Counter, instead of re-walking the dicts.
+
+    Comments are converted up front. Followers are converted on demand with
+    load_followers(), so a check that samples them only pays for the chunks
+    it reads; follower_total is the number converted so far.
+    """
+
+    def __init__(self, followers: Optional[List[Dict]] = None, engagement: Optional[Dict] = None):
+        self._followers = followers or []
+        engagement = engagement or {}
+        comments = engagement.get('comments', [])
+
+        # Interning tables (value -> code); a new value gets the next code
+        self._username_codes: Dict[str, int] = {}
+        self._location_codes: Dict[Any, int] = {}
+        usernames = self._username_codes
+        locations = self._location_codes
+        texts: Dict[str, int] = {}
+
+        # Follower columns (defaults match the follower check), filled by load_followers()
+        self.follower_available = len(self._followers)
+        self.follower_total = 0
+        self.follower_username: List[int] = []
+        self.follower_has_profile_pic: List[Any] = []
+        self.follower_post_count: List[Any] = []
+        self.follower_following: List[Any] = []
+        self.follower_followers: List[Any] = []
+        self.follower_account_age: List[Any] = []
+        self.follower_bio_length: List[Any] = []
+        self.follower_location: List[int] = []
+
+        # Comment columns
+        self.comment_total = len(comments)
+        self.comment_text = [texts.setdefault(c.get('text', ''), len(texts)) for c in comments]
+        self.comment_username = [usernames.setdefault(c.get('username', ''), len(usernames)) for c in comments]
+        self.comment_timestamp = [c.get('timestamp', MISSING) for c in comments]
+        self.comment_location = [locations.setdefault(c.get('location', MISSING), len(locations)) for c in comments]
+
+        # Interned values (code -> value)
+        self.usernames: List[str] = list(usernames)
+        self.locations: List[Any] = list(locations)
+        self.texts: List[str] = list(texts)
+
+        # Engagement totals
+        self.likes = engagement.get('likes', 0)
+        self.shares = engagement.get('shares', 0)
+        self.saves = engagement.get('saves', 0)
+
+    def load_followers(self, count: int) -> int:
+        """Convert followers up to index count (at most all of them); returns follower_total"""
+        rows = self._followers[self.follower_total:min(count, self.follower_available)]
+        if not rows:
+            return self.follower_total
+
+        usernames = self._username_codes
+        locations = self._location_codes
+        self.follower_username.extend([usernames.setdefault(f.get('username', ''), len(usernames)) for f in rows])
+        self.follower_has_profile_pic.extend([f.get('has_profile_pic', True) for f in rows])
+        self.follower_post_count.extend([f.get('post_count', 1) for f in rows])
+        self.follower_following.extend([f.get('following_count', 0) for f in rows])
+        self.follower_followers.extend([f.get('follower_count', 1) for f in rows])
+        self.follower_account_age.extend([f.get('account_age_days', 1000) for f in rows])
+        self.follower_bio_length.extend([f.get('bio_length', 1) for f in rows])
+        self.follower_location.extend([locations.setdefault(f.get('location', MISSING), len(locations)) for f in rows])
+
+        self.usernames.extend(islice(usernames, len(self.usernames), None))
+        self.locations.extend(islice(locations, len(self.locations), None))
+        self.follower_total += len(rows)
+        return self.follower_total
+
+    def location_counts(self, codes: List[int], default: str) -> Counter:
+        """
+        Count a location column by location name, MISSING counted as default
+        Keys are in first-seen order, as Counter over the raw values would be
+        """
+        return self.location_names(Counter(codes), default)
+
+    def location_names(self, code_counts: Counter, default: str) -> Counter:
+        """Re-key counts by location code as counts by location name"""
+        counts = Counter()
+        for code, count in code_counts.items():
+            location = self.locations[code]
+            counts[default if location is MISSING else location] += count
+        return counts
+
+    def location_value(self, code: int, default: Any) -> Any:
+        """Location for a code, or default if the key was absent"""
+        location = self.locations[code]
+        return default if location is MISSING else location
@@ -3,9 +3,11 @@ Velocity Check
 Detects suspicious engagement spikes and timing anomalies
 """
 import logging
-from typing import Dict, Any
+from typing import Dict, Any, Optional
 from datetime import datetime, timedelta
 from config import Config
+from models.post_batch import PostBatch, MISSING
+from engagement_baseline import BaselineStats
 
 logger = logging.getLogger(__name__)
 
@@ -14,13 +16,23 @@ class VelocityChecker:
     
     def __init__(self):
         self.anomaly_threshold = Config.FRAUD_DETECTION.get('velocity_anomaly_max', 2.5)
+        self.min_relative_std = Config.BASELINE['min_relative_std']
     
     def analyze(self, engagement: Dict, historical_avg: float, post_timestamp: datetime) -> Dict[str, Any]:
         """
         Analyze engagement velocity
         Compares current engagement rate to historical average
         """
-        current_engagement = self._calculate_engagement_rate(engagement)
+        return self.analyze_batch(PostBatch(engagement=engagement), historical_avg, post_timestamp)
+    
+    def analyze_batch(self, batch: PostBatch, historical_avg: float, post_timestamp: datetime,
+                      baseline: Optional[BaselineStats] = None) -> Dict[str, Any]:
+        """
+        Analyze the engagement totals and comment timestamps of a post batch
+        With the influencer's streaming baseline, its mean and standard
+        deviation replace historical_avg and the assumed 30% spread
+        """
+        current_engagement = self._calculate_engagement_rate(batch)
         time_since_post = (datetime.now() - post_timestamp).total_seconds() / 3600  # hours
         
         if time_since_post < 1:
@@ -30,14 +42,21 @@ class VelocityChecker:
         current_velocity = current_engagement / time_since_post
         
         # Compare to historical average
+        if baseline is not None:
+            historical_avg = baseline.mean
+            # Floor the spread so a very regular influencer is not flagged for small changes
+            std_dev = max(baseline.std_dev, baseline.mean * self.min_relative_std)
+        else:
+            # Assuming normal engagement varies by ~30% (1 std dev)
+            std_dev = historical_avg * 0.3
+        
         if historical_avg == 0:
             historical_avg = 1  # Avoid division by zero
+            std_dev = std_dev or 0.3
         
         velocity_ratio = current_velocity / historical_avg
         
         # Calculate standard deviations from normal
-        # Assuming normal engagement varies by ~30% (1 std dev)
-        std_dev = historical_avg * 0.3
         deviation = abs(current_velocity - historical_avg) / std_dev if std_dev > 0 else 0
         
         flags = []
@@ -57,7 +76,7 @@ class VelocityChecker:
         
         # Check for gradual dropoff pattern (sign of bought engagement wearing off)
         if time_since_post > 12:
-            early_engagement = self._estimate_early_engagement(engagement, post_timestamp)
+            early_engagement = self._estimate_early_engagement(batch, post_timestamp)
             if early_engagement > current_engagement * 1.5:
                 flags.append('Engagement dropped significantly after initial spike')
         
@@ -88,39 +107,35 @@ class VelocityChecker:
             'velocity_ratio': round(velocity_ratio, 2),
             'standard_deviations': round(deviation, 2),
             'time_since_post_hours': round(time_since_post, 2),
+            'baseline': {
+                'source': 'streaming' if baseline is not None else 'static',
+                'posts': baseline.posts if baseline is not None else 0,
+                'std_dev': round(std_dev, 2)
+            },
             'is_anomalous': is_anomalous,
             'flags': flags
         }
     
-    def _calculate_engagement_rate(self, engagement: Dict) -> float:
+    def _calculate_engagement_rate(self, batch: PostBatch) -> float:
         """Calculate total engagement"""
-        likes = engagement.get('likes', 0)
-        comments = len(engagement.get('comments', []))
-        shares = engagement.get('shares', 0)
-        saves = engagement.get('saves', 0)
-        
         # Weighted engagement (comments and shares worth more)
-        total_engagement = likes + (comments * 3) + (shares * 5) + (saves * 2)
+        total_engagement = batch.likes + (batch.comment_total * 3) + (batch.shares * 5) + (batch.saves * 2)
         return total_engagement
     
-    def _estimate_early_engagement(self, engagement: Dict, post_timestamp: datetime) -> float:
+    def _estimate_early_engagement(self, batch: PostBatch, post_timestamp: datetime) -> float:
         """Estimate engagement in first few hours"""
         # In a real system, we'd have time-series data
         # For simulation, we'll analyze comment timestamps
-        comments = engagement.get('comments', [])
-        
-        if not comments:
-            return self._calculate_engagement_rate(engagement)
+        if not batch.comment_total:
+            return self._calculate_engagement_rate(batch)
         
+        # A comment without a timestamp counts as posted now
         early_cutoff = post_timestamp + timedelta(hours=2)
-        early_comments = sum(1 for c in comments if c.get('timestamp', datetime.now()) < early_cutoff)
+        now = datetime.now()
+        early_comments = sum(1 for t in batch.comment_timestamp if (now if t is MISSING else t) < early_cutoff)
         
         # Estimate early engagement as proportional to early comments
-        total_comments = len(comments)
-        if total_comments == 0:
-            early_ratio = 0.5
-        else:
-            early_ratio = early_comments / total_comments
+        early_ratio = early_comments / batch.comment_total
         
-        total_engagement = self._calculate_engagement_rate(engagement)
-        return total_engagement * early_ratio / 0.2  # Normalize assuming early is ~20% of time
\ No newline at end of file
+        total_engagement = self._calculate_engagement_rate(batch)
+        return total_engagement * early_ratio / 0.2  # Normalize assuming early is ~20% of time
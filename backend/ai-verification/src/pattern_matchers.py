@@ -0,0 +1,84 @@
+"""
+Pattern Matchers
+Multi-pattern matchers compiled once from the fraud detection pattern lists
+"""
+import re
+from typing import Dict, List
+
+class PhraseMatcher:
+    """
+    Aho-Corasick automaton over a list of literal phrases
+
+    contains() answers "does the text contain any phrase" in one scan of the
+    text, however many phrases there are. Transitions are precomputed into a
+    full DFA (failure links folded in), so the scan is one dict lookup per
+    character.
+    """
+
+    def __init__(self, phrases: List[str]):
+        self.phrases = [p for p in dict.fromkeys(phrases) if p]
+        self._delta: List[Dict[str, int]] = [{}]
+        self._terminal: List[bool] = [False]
+
+        # Trie of the phrases
+        for phrase in self.phrases:
+            state = 0
+            for ch in phrase:
+                next_state = self._delta[state].get(ch)
+                if next_state is None:
+                    next_state = len(self._delta)
+                    self._delta[state][ch] = next_state
+                    self._delta.append({})
+                    self._terminal.append(False)
+                state = next_state
+            self._terminal[state] = True
+
+        # Breadth-first: a state inherits its failure state's transitions and
+        # terminal flag, so any transition not listed goes to the root
+        goto = [dict(edges) for edges in self._delta]
+        fail = [0] * len(goto)
+        queue = list(goto[0].values())
+        for state in queue:
+            self._delta[state] = {**self._delta[fail[state]], **goto[state]}
+            self._terminal[state] = self._terminal[state] or self._terminal[fail[state]]
+            for ch, child in goto[state].items():
+                fail[child] = self._delta[fail[state]].get(ch, 0)
+                queue.append(child)
+
+    def contains(self, text: str) -> bool:
+        """True if any phrase occurs in text"""
+        delta = self._delta
+        terminal = self._terminal
+        state = 0
+        for ch in text:
+            state = delta[state].get(ch, 0)
+            if terminal[state]:
+                return True
+        return False
+
+    def __len__(self) -> int:
+        return len(self.phrases)
+
+class RegexSetMatcher:
+    """
+    A list of regexes merged into one alternation
+
+    matches() is true if any pattern matches at the start of the text (the
+    same as any(re.match(p, text) for p in patterns)) and costs one call into
+    the regex engine. Patterns must not use numbered backreferences, since
+    merging renumbers their groups.
+    """
+
+    def __init__(self, patterns: List[str]):
+        self.patterns = list(patterns)
+        for pattern in self.patterns:
+            re.compile(pattern)  # Report a bad pattern by itself, not the merged one
+        merged = '|'.join(f'(?:{pattern})' for pattern in self.patterns)
+        self._regex = re.compile(merged) if self.patterns else None
+
+    def matches(self, text: str) -> bool:
+        """True if any pattern matches at the start of text"""
+        return self._regex is not None and self._regex.match(text) is not None
+
+    def __len__(self) -> int:
+        return len(self.patterns)
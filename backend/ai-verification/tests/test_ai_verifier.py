@@ -26,6 +26,10 @@ class IntegrationTester:
             ("Bot Fraud Detection Flow", self.test_bot_fraud_flow),
             ("Mixed Quality Flow", self.test_mixed_quality_flow),
             ("Score Threshold Validation", self.test_threshold_validation),
+            ("Batch Verification", self.test_batch_verification),
+            ("Result Cache", self.test_result_cache),
+            ("Prometheus Metrics", self.test_metrics),
+            ("Engagement Baseline", self.test_engagement_baseline),
             ("Error Handling", self.test_error_handling)
         ]
         
@@ -132,6 +136,12 @@ class IntegrationTester:
         assert len(ai_result['fraud_flags']) > 0, "Expected fraud flags"
         assert 'REJECT' in ai_result['recommendation'] or 'HOLD' in ai_result['recommendation'], \
             "Expected REJECT or HOLD recommendation"
+        
+        # Clear-cut fraud stops sampling early
+        samples = ai_result['samples_used']
+        print(f"  Followers sampled: {samples['follower_authenticity']}/{samples['followers_available']}")
+        assert samples['follower_authenticity'] < samples['followers_available'], \
+            "Expected early-terminated follower sampling"
     
     def test_mixed_quality_flow(self):
         """Test mixed quality campaign"""
@@ -154,6 +164,11 @@ class IntegrationTester:
         # Should be in middle range
         assert 60 <= ai_result['overall_score'] < 95, \
             f"Expected score 60-95, got {ai_result['overall_score']}"
+        
+        # Borderline audiences get the full follower sample
+        samples = ai_result['samples_used']
+        assert samples['follower_authenticity'] == samples['followers_available'], \
+            "Expected the full follower sample for a borderline post"
     
     def test_threshold_validation(self):
         """Test score threshold logic"""
@@ -169,6 +184,109 @@ class IntegrationTester:
         weight_sum = sum(data['weights'].values())
         assert abs(weight_sum - 1.0) < 0.001, f"Weights must sum to 1.0, got {weight_sum}"
     
+    def test_batch_verification(self):
+        """Test batch verification matches per-post verification"""
+        batch_request = {
+            "requests": [
+                {"post_url": "https://instagram.com/p/batch_legit", "scenario": "legitimate"},
+                {"post_url": "https://instagram.com/p/batch_bot", "scenario": "bot_fraud"},
+                {"post_url": "https://instagram.com/p/batch_invalid", "scenario": "invalid_scenario"}
+            ]
+        }
+        
+        response = requests.post(
+            f"{self.ai_service_url}/verify/batch",
+            json=batch_request,
+            timeout=10
+        )
+        assert response.status_code == 200, "Batch verification failed"
+        
+        data = response.json()
+        results = data['results']
+        print(f"  Batch: {data['count']} results, {data['failed']} failed")
+        
+        # Results come back in request order, one per request
+        assert data['count'] == 3 and len(results) == 3, "Expected 3 results"
+        assert data['failed'] == 1, f"Expected 1 failure, got {data['failed']}"
+        for item, result in zip(batch_request['requests'], results):
+            assert result['post_url'] == item['post_url'], "Results out of order"
+        
+        # Same scores as /verify (scenario data is fixed per service run)
+        for item, result in zip(batch_request['requests'][:2], results[:2]):
+            single = requests.post(f"{self.ai_service_url}/verify", json=item, timeout=10).json()
+            assert result['overall_score'] == single['overall_score'], \
+                f"Batch score {result['overall_score']} != single {single['overall_score']}"
+        
+        assert 'error' in results[2], "Expected an error entry for the invalid scenario"
+        
+        # Malformed batches are rejected outright
+        response = requests.post(f"{self.ai_service_url}/verify/batch", json={"requests": []}, timeout=5)
+        assert response.status_code == 400, "Expected 400 for an empty batch"
+    
+    def test_result_cache(self):
+        """Test repeat verifications are served from the result cache"""
+        ai_request = {
+            "post_url": "https://instagram.com/p/cache_integration_test",
+            "scenario": "legitimate"
+        }
+        
+        requests.post(f"{self.ai_service_url}/cache/invalidate",
+                      json={"post_url": ai_request['post_url']}, timeout=5)
+        before = requests.get(f"{self.ai_service_url}/health", timeout=5).json()['cache']
+        
+        first = requests.post(f"{self.ai_service_url}/verify", json=ai_request, timeout=10).json()
+        second = requests.post(f"{self.ai_service_url}/verify", json=ai_request, timeout=10).json()
+        
+        after = requests.get(f"{self.ai_service_url}/health", timeout=5).json()['cache']
+        print(f"  Cache: {after['hits']} hits, {after['misses']} misses, {after['size']} entries")
+        
+        assert second['overall_score'] == first['overall_score'], "Cached score differs"
+        assert after['misses'] == before['misses'] + 1, "Expected one miss"
+        assert after['hits'] == before['hits'] + 1, "Expected one hit"
+        
+        # Invalidation forces a fresh computation
+        response = requests.post(f"{self.ai_service_url}/cache/invalidate",
+                                 json={"post_url": ai_request['post_url']}, timeout=5)
+        assert response.json()['invalidated'] == 1, "Expected one invalidated entry"
+    
+    def test_metrics(self):
+        """Test /metrics exposes checker latencies and request counts"""
+        requests.post(f"{self.ai_service_url}/verify",
+                      json={"post_url": "https://instagram.com/p/metrics_test", "scenario": "legitimate"},
+                      timeout=10)
+        
+        response = requests.get(f"{self.ai_service_url}/metrics", timeout=5)
+        assert response.status_code == 200, "Expected 200 from /metrics"
+        assert response.headers['Content-Type'].startswith('text/plain'), "Expected Prometheus text format"
+        
+        body = response.text
+        for checker in ('follower', 'engagement', 'velocity', 'geo'):
+            assert f'ai_checker_duration_seconds_count{{checker="{checker}"}}' in body, f"Missing {checker} histogram"
+        assert 'ai_requests_total{endpoint="/verify",status="200"}' in body, "Missing /verify request count"
+        print(f"  {len(body.splitlines())} metric lines")
+    
+    def test_engagement_baseline(self):
+        """Test the velocity check switches to the streaming baseline after enough posts"""
+        baselines = requests.get(f"{self.ai_service_url}/health", timeout=5).json()['baselines']
+        if baselines.get('enabled') is False:
+            print("  Engagement baseline disabled, skipping")
+            return
+        
+        run = int(time.time())
+        velocity = None
+        for i in range(baselines['min_posts'] + 1):
+            response = requests.post(f"{self.ai_service_url}/verify",
+                                     json={"post_url": f"https://instagram.com/p/baseline_{run}_{i}",
+                                           "scenario": "legitimate"},
+                                     timeout=10)
+            assert response.status_code == 200, "AI verification failed"
+            velocity = response.json()['breakdown']['velocity_check']['details']
+        
+        assert velocity['baseline']['source'] == 'streaming', "Expected the streaming baseline"
+        assert velocity['baseline']['posts'] >= baselines['min_posts'], "Expected min_posts baseline posts"
+        print(f"  Baseline over {velocity['baseline']['posts']} posts: "
+              f"{velocity['historical_average']}/hr ± {velocity['baseline']['std_dev']}")
+    
     def test_error_handling(self):
         """Test error handling"""
         # Test missing post_url
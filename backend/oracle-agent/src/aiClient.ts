@@ -44,6 +44,39 @@ export class AIClient {
     }
   }
 
+  /**
+   * Request verification of many posts in one call to /verify/batch
+   * Resolves with one entry per request, in order: the result, or an Error
+   * for a post the service could not verify. Rejects if the call itself fails.
+   */
+  async verifyBatch(requests: VerificationRequest[]): Promise<Array<VerificationResult | Error>> {
+    try {
+      console.log(`[AI Client] Requesting batch verification for ${requests.length} posts`);
+
+      const pythonRequest = {
+        requests: requests.map(request => ({
+          post_url: request.postUrl,
+          scenario: request.scenario
+        }))
+      };
+
+      const response = await this.client.post('/verify/batch', pythonRequest);
+      const results: any[] = response.data.results || [];
+      if (results.length !== requests.length) {
+        throw new Error(`expected ${requests.length} batch results, got ${results.length}`);
+      }
+
+      console.log(`[AI Client] Batch verification complete: ${results.length - response.data.failed}/${results.length} scored`);
+
+      return results.map(result => result.error !== undefined
+        ? new Error(`AI Service error: ${result.error}`)
+        : result as VerificationResult);
+    } catch (error: any) {
+      const message = error?.response?.data?.error || error?.message || 'Unknown error';
+      throw new Error(`AI Service error: ${message}`);
+    }
+  }
+
   /**
    * Health check for AI service
    */
@@ -12,7 +12,11 @@ export class Config {
     contractId: process.env.CONTRACT_ID || '',
     oraclePrivateKey: process.env.ORACLE_PRIVATE_KEY || '',
     oraclePublicKey: process.env.ORACLE_PUBLIC_KEY || '',
-    networkId: parseInt(process.env.NETWORK_ID || '1', 10)
+    networkId: parseInt(process.env.NETWORK_ID || '1', 10),
+    contractIndex: parseInt(process.env.CONTRACT_INDEX || '0', 10),
+    rpcMaxSockets: parseInt(process.env.RPC_MAX_SOCKETS || '8', 10),
+    rpcBatching: (process.env.RPC_BATCHING || 'true') === 'true',
+    rpcMaxBatchSize: parseInt(process.env.RPC_MAX_BATCH_SIZE || '32', 10)
   };
 
   static readonly AI_SERVICE: AIServiceConfig = {
@@ -24,7 +28,14 @@ export class Config {
     pollingIntervalMs: parseInt(process.env.POLLING_INTERVAL_MS || '5000', 10),
     maxRetries: parseInt(process.env.MAX_RETRIES || '3', 10),
     retryDelayMs: parseInt(process.env.RETRY_DELAY_MS || '2000', 10),
-    batchSize: parseInt(process.env.BATCH_SIZE || '10', 10)
+    batchSize: parseInt(process.env.BATCH_SIZE || '10', 10),
+    confirmationPollMs: parseInt(process.env.CONFIRMATION_POLL_MS || '1000', 10),
+    aiConcurrency: parseInt(process.env.AI_CONCURRENCY || '4', 10),
+    aiBatchSize: parseInt(process.env.AI_BATCH_SIZE || '16', 10),
+    submitConcurrency: parseInt(process.env.SUBMIT_CONCURRENCY || '2', 10),
+    maxQueueDepth: parseInt(process.env.MAX_QUEUE_DEPTH || '256', 10),
+    stateDir: process.env.STATE_DIR || './data',
+    snapshotEvery: parseInt(process.env.STATE_SNAPSHOT_EVERY || '1000', 10)
   };
 
   static readonly SERVER = {
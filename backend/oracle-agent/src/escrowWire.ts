@@ -0,0 +1,962 @@
+/**
+ * Escrow Contract Wire Layout
+ * GENERATED from contracts/src/escrow_wire.h by contracts/test/gen_wire_layout.cpp
+ * Do not edit by hand; regenerate after changing the header.
+ */
+
+/** Procedure input types (transaction inputType) */
+export enum EscrowProcedure {
+  DEPOSIT_FUNDS = 0,
+  SET_VERIFICATION_SCORE = 1,
+  RELEASE_PAYMENT = 2,
+  REFUND_FUNDS = 3,
+  SET_ORACLE_ID = 4,
+  SET_VERIFICATION_SCORE_BATCH = 5,
+  DEPOSIT_FUNDS_BATCH = 6,
+  SET_ORACLE_SET = 7,
+  SUBMIT_COSIGNED_SCORES = 8,
+  DEPOSIT_STREAM = 9,
+  CLAIM_STREAM = 10
+}
+
+/** Function input types (querySmartContract inputType) */
+export enum EscrowFunction {
+  GET_CONTRACT_STATE = 0,
+  GET_ESCROWS_PAGE = 1,
+  GET_EVENTS_SINCE = 2,
+  GET_AGGREGATES = 3,
+  GET_STREAM = 4
+}
+
+/** Escrow lifecycle */
+export enum EscrowStatus {
+  FREE = 0,
+  PENDING = 1,
+  VERIFIED = 2,
+  PAID = 3,
+  REFUNDED = 4
+}
+
+/** Kind of a typed event in the contract's event ring */
+export enum EscrowEventKind {
+  NONE = 0,
+  ORACLE_SET = 1,
+  DEPOSITED = 2,
+  VERIFIED = 3,
+  RELEASED = 4,
+  REFUNDED = 5,
+  FEES_SWEPT = 6,
+  RECLAIMED = 7,
+  SCORE_SUBMITTED = 8,
+  STREAM_CLAIMED = 9
+}
+
+/** How the scores of an oracle set combine into the verification score */
+export enum EscrowScoreAggregation {
+  MEDIAN = 0,
+  THRESHOLD = 1
+}
+
+/** getEscrowsPage party filter */
+export enum EscrowPartyFilter {
+  ANY = 0,
+  BRAND = 1,
+  INFLUENCER = 2
+}
+
+export const ESCROW_STATUS_ANY = 255;
+export const ESCROW_PAGE_SIZE = 16;
+export const EVENT_PAGE_SIZE = 32;
+export const MAX_SCORE_BATCH = 256;
+export const SCORE_BATCH_HEADER_SIZE = 4;
+export const MAX_DEPOSIT_BATCH = 200;
+export const MAX_ORACLES = 8;
+export const MAX_COSIGNED_SCORES = 64;
+export const COSIGNED_SCORES_HEADER_SIZE = 4;
+export const MAX_STREAM_TICKS = 5256000;
+
+/** Identifies one campaign escrow: byte offsets */
+export const EscrowKeyLayout = {
+  size: 72,
+  brandId: 0,
+  influencerId: 32,
+  campaignNonce: 64,
+} as const;
+
+/** Identifies one campaign escrow: fixed-offset view, reads and writes the underlying bytes in place */
+export class EscrowKeyView {
+  static readonly SIZE = 72;
+  private readonly view: DataView;
+
+  constructor(readonly bytes: Uint8Array) {
+    if (bytes.byteLength < 72) {
+      throw new RangeError(`EscrowKey needs 72 bytes, got ${bytes.byteLength}`);
+    }
+    this.view = new DataView(bytes.buffer, bytes.byteOffset, 72);
+  }
+
+  /** Zero-filled buffer ready to be populated */
+  static alloc(): EscrowKeyView {
+    return new EscrowKeyView(new Uint8Array(72));
+  }
+
+  get brandId(): Uint8Array { return this.bytes.subarray(0, 32); }
+  set brandId(value: Uint8Array) { this.bytes.set(value.subarray(0, 32), 0); }
+  get influencerId(): Uint8Array { return this.bytes.subarray(32, 64); }
+  set influencerId(value: Uint8Array) { this.bytes.set(value.subarray(0, 32), 32); }
+  get campaignNonce(): bigint { return this.view.getBigUint64(64, true); }
+  set campaignNonce(value: bigint) { this.view.setBigUint64(64, value, true); }
+}
+
+/** depositFunds input (brandId is the transaction source): byte offsets */
+export const DepositInputLayout = {
+  size: 56,
+  amount: 0,
+  influencerId: 8,
+  retentionDays: 40,
+  campaignNonce: 48,
+} as const;
+
+/** depositFunds input (brandId is the transaction source): fixed-offset view, reads and writes the underlying bytes in place */
+export class DepositInputView {
+  static readonly SIZE = 56;
+  private readonly view: DataView;
+
+  constructor(readonly bytes: Uint8Array) {
+    if (bytes.byteLength < 56) {
+      throw new RangeError(`DepositInput needs 56 bytes, got ${bytes.byteLength}`);
+    }
+    this.view = new DataView(bytes.buffer, bytes.byteOffset, 56);
+  }
+
+  /** Zero-filled buffer ready to be populated */
+  static alloc(): DepositInputView {
+    return new DepositInputView(new Uint8Array(56));
+  }
+
+  get amount(): bigint { return this.view.getBigInt64(0, true); }
+  set amount(value: bigint) { this.view.setBigInt64(0, value, true); }
+  get influencerId(): Uint8Array { return this.bytes.subarray(8, 40); }
+  set influencerId(value: Uint8Array) { this.bytes.set(value.subarray(0, 32), 8); }
+  get retentionDays(): number { return this.view.getUint32(40, true); }
+  set retentionDays(value: number) { this.view.setUint32(40, value, true); }
+  get campaignNonce(): bigint { return this.view.getBigUint64(48, true); }
+  set campaignNonce(value: bigint) { this.view.setBigUint64(48, value, true); }
+}
+
+/** depositFunds output: byte offsets */
+export const DepositOutputLayout = {
+  size: 4,
+  slot: 0,
+} as const;
+
+/** depositFunds output: fixed-offset view, reads and writes the underlying bytes in place */
+export class DepositOutputView {
+  static readonly SIZE = 4;
+  private readonly view: DataView;
+
+  constructor(readonly bytes: Uint8Array) {
+    if (bytes.byteLength < 4) {
+      throw new RangeError(`DepositOutput needs 4 bytes, got ${bytes.byteLength}`);
+    }
+    this.view = new DataView(bytes.buffer, bytes.byteOffset, 4);
+  }
+
+  /** Zero-filled buffer ready to be populated */
+  static alloc(): DepositOutputView {
+    return new DepositOutputView(new Uint8Array(4));
+  }
+
+  get slot(): number { return this.view.getUint32(0, true); }
+  set slot(value: number) { this.view.setUint32(0, value, true); }
+}
+
+/** depositFundsBatch input header: byte offsets */
+export const DepositBatchHeaderLayout = {
+  size: 24,
+  totalAmount: 0,
+  campaignNonce: 8,
+  count: 16,
+} as const;
+
+/** depositFundsBatch input header: fixed-offset view, reads and writes the underlying bytes in place */
+export class DepositBatchHeaderView {
+  static readonly SIZE = 24;
+  private readonly view: DataView;
+
+  constructor(readonly bytes: Uint8Array) {
+    if (bytes.byteLength < 24) {
+      throw new RangeError(`DepositBatchHeader needs 24 bytes, got ${bytes.byteLength}`);
+    }
+    this.view = new DataView(bytes.buffer, bytes.byteOffset, 24);
+  }
+
+  /** Zero-filled buffer ready to be populated */
+  static alloc(): DepositBatchHeaderView {
+    return new DepositBatchHeaderView(new Uint8Array(24));
+  }
+
+  get totalAmount(): bigint { return this.view.getBigInt64(0, true); }
+  set totalAmount(value: bigint) { this.view.setBigInt64(0, value, true); }
+  get campaignNonce(): bigint { return this.view.getBigUint64(8, true); }
+  set campaignNonce(value: bigint) { this.view.setBigUint64(8, value, true); }
+  get count(): number { return this.view.getUint32(16, true); }
+  set count(value: number) { this.view.setUint32(16, value, true); }
+}
+
+/** One depositFundsBatch entry: byte offsets */
+export const DepositBatchEntryLayout = {
+  size: 48,
+  influencerId: 0,
+  amount: 32,
+  retentionDays: 40,
+} as const;
+
+/** One depositFundsBatch entry: fixed-offset view, reads and writes the underlying bytes in place */
+export class DepositBatchEntryView {
+  static readonly SIZE = 48;
+  private readonly view: DataView;
+
+  constructor(readonly bytes: Uint8Array) {
+    if (bytes.byteLength < 48) {
+      throw new RangeError(`DepositBatchEntry needs 48 bytes, got ${bytes.byteLength}`);
+    }
+    this.view = new DataView(bytes.buffer, bytes.byteOffset, 48);
+  }
+
+  /** Zero-filled buffer ready to be populated */
+  static alloc(): DepositBatchEntryView {
+    return new DepositBatchEntryView(new Uint8Array(48));
+  }
+
+  get influencerId(): Uint8Array { return this.bytes.subarray(0, 32); }
+  set influencerId(value: Uint8Array) { this.bytes.set(value.subarray(0, 32), 0); }
+  get amount(): bigint { return this.view.getBigInt64(32, true); }
+  set amount(value: bigint) { this.view.setBigInt64(32, value, true); }
+  get retentionDays(): number { return this.view.getUint32(40, true); }
+  set retentionDays(value: number) { this.view.setUint32(40, value, true); }
+}
+
+/** depositFundsBatch output: byte offsets */
+export const DepositBatchOutputLayout = {
+  size: 804,
+  count: 0,
+  slots: 4,
+} as const;
+
+/** depositFundsBatch output: fixed-offset view, reads and writes the underlying bytes in place */
+export class DepositBatchOutputView {
+  static readonly SIZE = 804;
+  private readonly view: DataView;
+
+  constructor(readonly bytes: Uint8Array) {
+    if (bytes.byteLength < 804) {
+      throw new RangeError(`DepositBatchOutput needs 804 bytes, got ${bytes.byteLength}`);
+    }
+    this.view = new DataView(bytes.buffer, bytes.byteOffset, 804);
+  }
+
+  /** Zero-filled buffer ready to be populated */
+  static alloc(): DepositBatchOutputView {
+    return new DepositBatchOutputView(new Uint8Array(804));
+  }
+
+  get count(): number { return this.view.getUint32(0, true); }
+  set count(value: number) { this.view.setUint32(0, value, true); }
+  slotsAt(index: number): number {
+    if (index < 0 || index >= 200) {
+      throw new RangeError(`slots index ${index} out of range`);
+    }
+    return this.view.getUint32(4 + index * 4, true);
+  }
+}
+
+/** depositStream input (brandId is the transaction source): byte offsets */
+export const StreamDepositInputLayout = {
+  size: 56,
+  amount: 0,
+  ratePerTick: 8,
+  influencerId: 16,
+  campaignNonce: 48,
+} as const;
+
+/** depositStream input (brandId is the transaction source): fixed-offset view, reads and writes the underlying bytes in place */
+export class StreamDepositInputView {
+  static readonly SIZE = 56;
+  private readonly view: DataView;
+
+  constructor(readonly bytes: Uint8Array) {
+    if (bytes.byteLength < 56) {
+      throw new RangeError(`StreamDepositInput needs 56 bytes, got ${bytes.byteLength}`);
+    }
+    this.view = new DataView(bytes.buffer, bytes.byteOffset, 56);
+  }
+
+  /** Zero-filled buffer ready to be populated */
+  static alloc(): StreamDepositInputView {
+    return new StreamDepositInputView(new Uint8Array(56));
+  }
+
+  get amount(): bigint { return this.view.getBigInt64(0, true); }
+  set amount(value: bigint) { this.view.setBigInt64(0, value, true); }
+  get ratePerTick(): bigint { return this.view.getBigInt64(8, true); }
+  set ratePerTick(value: bigint) { this.view.setBigInt64(8, value, true); }
+  get influencerId(): Uint8Array { return this.bytes.subarray(16, 48); }
+  set influencerId(value: Uint8Array) { this.bytes.set(value.subarray(0, 32), 16); }
+  get campaignNonce(): bigint { return this.view.getBigUint64(48, true); }
+  set campaignNonce(value: bigint) { this.view.setBigUint64(48, value, true); }
+}
+
+/** claimStream output (input is an EscrowKey): byte offsets */
+export const StreamClaimOutputLayout = {
+  size: 16,
+  amount: 0,
+  claimed: 8,
+} as const;
+
+/** claimStream output (input is an EscrowKey): fixed-offset view, reads and writes the underlying bytes in place */
+export class StreamClaimOutputView {
+  static readonly SIZE = 16;
+  private readonly view: DataView;
+
+  constructor(readonly bytes: Uint8Array) {
+    if (bytes.byteLength < 16) {
+      throw new RangeError(`StreamClaimOutput needs 16 bytes, got ${bytes.byteLength}`);
+    }
+    this.view = new DataView(bytes.buffer, bytes.byteOffset, 16);
+  }
+
+  /** Zero-filled buffer ready to be populated */
+  static alloc(): StreamClaimOutputView {
+    return new StreamClaimOutputView(new Uint8Array(16));
+  }
+
+  get amount(): bigint { return this.view.getBigInt64(0, true); }
+  set amount(value: bigint) { this.view.setBigInt64(0, value, true); }
+  get claimed(): bigint { return this.view.getBigInt64(8, true); }
+  set claimed(value: bigint) { this.view.setBigInt64(8, value, true); }
+}
+
+/** getStream output (input is an EscrowKey): byte offsets */
+export const StreamStateResponseLayout = {
+  size: 48,
+  budget: 0,
+  ratePerTick: 8,
+  accrued: 16,
+  claimed: 24,
+  startTick: 32,
+  endTick: 36,
+  status: 40,
+  verificationScore: 41,
+  claimable: 42,
+} as const;
+
+/** getStream output (input is an EscrowKey): fixed-offset view, reads and writes the underlying bytes in place */
+export class StreamStateResponseView {
+  static readonly SIZE = 48;
+  private readonly view: DataView;
+
+  constructor(readonly bytes: Uint8Array) {
+    if (bytes.byteLength < 48) {
+      throw new RangeError(`StreamStateResponse needs 48 bytes, got ${bytes.byteLength}`);
+    }
+    this.view = new DataView(bytes.buffer, bytes.byteOffset, 48);
+  }
+
+  /** Zero-filled buffer ready to be populated */
+  static alloc(): StreamStateResponseView {
+    return new StreamStateResponseView(new Uint8Array(48));
+  }
+
+  get budget(): bigint { return this.view.getBigInt64(0, true); }
+  set budget(value: bigint) { this.view.setBigInt64(0, value, true); }
+  get ratePerTick(): bigint { return this.view.getBigInt64(8, true); }
+  set ratePerTick(value: bigint) { this.view.setBigInt64(8, value, true); }
+  get accrued(): bigint { return this.view.getBigInt64(16, true); }
+  set accrued(value: bigint) { this.view.setBigInt64(16, value, true); }
+  get claimed(): bigint { return this.view.getBigInt64(24, true); }
+  set claimed(value: bigint) { this.view.setBigInt64(24, value, true); }
+  get startTick(): number { return this.view.getUint32(32, true); }
+  set startTick(value: number) { this.view.setUint32(32, value, true); }
+  get endTick(): number { return this.view.getUint32(36, true); }
+  set endTick(value: number) { this.view.setUint32(36, value, true); }
+  get status(): EscrowStatus { return this.view.getUint8(40); }
+  set status(value: EscrowStatus) { this.view.setUint8(40, value); }
+  get verificationScore(): number { return this.view.getUint8(41); }
+  set verificationScore(value: number) { this.view.setUint8(41, value); }
+  get claimable(): boolean { return this.view.getUint8(42) !== 0; }
+  set claimable(value: boolean) { this.view.setUint8(42, value ? 1 : 0); }
+}
+
+/** setVerificationScore input: byte offsets */
+export const ScoreInputLayout = {
+  size: 80,
+  key: 0,
+  score: 72,
+} as const;
+
+/** setVerificationScore input: fixed-offset view, reads and writes the underlying bytes in place */
+export class ScoreInputView {
+  static readonly SIZE = 80;
+  private readonly view: DataView;
+
+  constructor(readonly bytes: Uint8Array) {
+    if (bytes.byteLength < 80) {
+      throw new RangeError(`ScoreInput needs 80 bytes, got ${bytes.byteLength}`);
+    }
+    this.view = new DataView(bytes.buffer, bytes.byteOffset, 80);
+  }
+
+  /** Zero-filled buffer ready to be populated */
+  static alloc(): ScoreInputView {
+    return new ScoreInputView(new Uint8Array(80));
+  }
+
+  get key(): EscrowKeyView { return new EscrowKeyView(this.bytes.subarray(0, 72)); }
+  get score(): number { return this.view.getUint8(72); }
+  set score(value: number) { this.view.setUint8(72, value); }
+}
+
+/** One setVerificationScoreBatch entry: byte offsets */
+export const ScoreBatchEntryLayout = {
+  size: 12,
+  slot: 0,
+  depositTick: 4,
+  score: 8,
+} as const;
+
+/** One setVerificationScoreBatch entry: fixed-offset view, reads and writes the underlying bytes in place */
+export class ScoreBatchEntryView {
+  static readonly SIZE = 12;
+  private readonly view: DataView;
+
+  constructor(readonly bytes: Uint8Array) {
+    if (bytes.byteLength < 12) {
+      throw new RangeError(`ScoreBatchEntry needs 12 bytes, got ${bytes.byteLength}`);
+    }
+    this.view = new DataView(bytes.buffer, bytes.byteOffset, 12);
+  }
+
+  /** Zero-filled buffer ready to be populated */
+  static alloc(): ScoreBatchEntryView {
+    return new ScoreBatchEntryView(new Uint8Array(12));
+  }
+
+  get slot(): number { return this.view.getUint32(0, true); }
+  set slot(value: number) { this.view.setUint32(0, value, true); }
+  get depositTick(): number { return this.view.getUint32(4, true); }
+  set depositTick(value: number) { this.view.setUint32(4, value, true); }
+  get score(): number { return this.view.getUint8(8); }
+  set score(value: number) { this.view.setUint8(8, value); }
+}
+
+/** setVerificationScoreBatch / submitCosignedScores output: byte offsets */
+export const ScoreBatchOutputLayout = {
+  size: 4,
+  applied: 0,
+} as const;
+
+/** setVerificationScoreBatch / submitCosignedScores output: fixed-offset view, reads and writes the underlying bytes in place */
+export class ScoreBatchOutputView {
+  static readonly SIZE = 4;
+  private readonly view: DataView;
+
+  constructor(readonly bytes: Uint8Array) {
+    if (bytes.byteLength < 4) {
+      throw new RangeError(`ScoreBatchOutput needs 4 bytes, got ${bytes.byteLength}`);
+    }
+    this.view = new DataView(bytes.buffer, bytes.byteOffset, 4);
+  }
+
+  /** Zero-filled buffer ready to be populated */
+  static alloc(): ScoreBatchOutputView {
+    return new ScoreBatchOutputView(new Uint8Array(4));
+  }
+
+  get applied(): number { return this.view.getUint32(0, true); }
+  set applied(value: number) { this.view.setUint32(0, value, true); }
+}
+
+/** setOracleSet input: byte offsets */
+export const OracleSetInputLayout = {
+  size: 264,
+  oracles: 0,
+  count: 256,
+  quorum: 257,
+  aggregation: 258,
+} as const;
+
+/** setOracleSet input: fixed-offset view, reads and writes the underlying bytes in place */
+export class OracleSetInputView {
+  static readonly SIZE = 264;
+  private readonly view: DataView;
+
+  constructor(readonly bytes: Uint8Array) {
+    if (bytes.byteLength < 264) {
+      throw new RangeError(`OracleSetInput needs 264 bytes, got ${bytes.byteLength}`);
+    }
+    this.view = new DataView(bytes.buffer, bytes.byteOffset, 264);
+  }
+
+  /** Zero-filled buffer ready to be populated */
+  static alloc(): OracleSetInputView {
+    return new OracleSetInputView(new Uint8Array(264));
+  }
+
+  oraclesAt(index: number): Uint8Array {
+    if (index < 0 || index >= 8) {
+      throw new RangeError(`oracles index ${index} out of range`);
+    }
+    const offset = 0 + index * 32;
+    return this.bytes.subarray(offset, offset + 32);
+  }
+  get count(): number { return this.view.getUint8(256); }
+  set count(value: number) { this.view.setUint8(256, value); }
+  get quorum(): number { return this.view.getUint8(257); }
+  set quorum(value: number) { this.view.setUint8(257, value); }
+  get aggregation(): EscrowScoreAggregation { return this.view.getUint8(258); }
+  set aggregation(value: EscrowScoreAggregation) { this.view.setUint8(258, value); }
+}
+
+/** What an oracle signs (K12 digest) for submitCosignedScores: byte offsets */
+export const CosignedScoreMessageLayout = {
+  size: 88,
+  key: 0,
+  slot: 72,
+  depositTick: 76,
+  score: 80,
+} as const;
+
+/** What an oracle signs (K12 digest) for submitCosignedScores: fixed-offset view, reads and writes the underlying bytes in place */
+export class CosignedScoreMessageView {
+  static readonly SIZE = 88;
+  private readonly view: DataView;
+
+  constructor(readonly bytes: Uint8Array) {
+    if (bytes.byteLength < 88) {
+      throw new RangeError(`CosignedScoreMessage needs 88 bytes, got ${bytes.byteLength}`);
+    }
+    this.view = new DataView(bytes.buffer, bytes.byteOffset, 88);
+  }
+
+  /** Zero-filled buffer ready to be populated */
+  static alloc(): CosignedScoreMessageView {
+    return new CosignedScoreMessageView(new Uint8Array(88));
+  }
+
+  get key(): EscrowKeyView { return new EscrowKeyView(this.bytes.subarray(0, 72)); }
+  get slot(): number { return this.view.getUint32(72, true); }
+  set slot(value: number) { this.view.setUint32(72, value, true); }
+  get depositTick(): number { return this.view.getUint32(76, true); }
+  set depositTick(value: number) { this.view.setUint32(76, value, true); }
+  get score(): number { return this.view.getUint8(80); }
+  set score(value: number) { this.view.setUint8(80, value); }
+}
+
+/** One submitCosignedScores entry: byte offsets */
+export const CosignedScoreEntryLayout = {
+  size: 72,
+  slot: 0,
+  score: 4,
+  oracleIndex: 5,
+  signature: 8,
+} as const;
+
+/** One submitCosignedScores entry: fixed-offset view, reads and writes the underlying bytes in place */
+export class CosignedScoreEntryView {
+  static readonly SIZE = 72;
+  private readonly view: DataView;
+
+  constructor(readonly bytes: Uint8Array) {
+    if (bytes.byteLength < 72) {
+      throw new RangeError(`CosignedScoreEntry needs 72 bytes, got ${bytes.byteLength}`);
+    }
+    this.view = new DataView(bytes.buffer, bytes.byteOffset, 72);
+  }
+
+  /** Zero-filled buffer ready to be populated */
+  static alloc(): CosignedScoreEntryView {
+    return new CosignedScoreEntryView(new Uint8Array(72));
+  }
+
+  get slot(): number { return this.view.getUint32(0, true); }
+  set slot(value: number) { this.view.setUint32(0, value, true); }
+  get score(): number { return this.view.getUint8(4); }
+  set score(value: number) { this.view.setUint8(4, value); }
+  get oracleIndex(): number { return this.view.getUint8(5); }
+  set oracleIndex(value: number) { this.view.setUint8(5, value); }
+  get signature(): Uint8Array { return this.bytes.subarray(8, 72); }
+  set signature(value: Uint8Array) { this.bytes.set(value.subarray(0, 64), 8); }
+}
+
+/** getContractState output (input is an EscrowKey): byte offsets */
+export const StateResponseLayout = {
+  size: 128,
+  brandId: 0,
+  influencerId: 32,
+  oracleId: 64,
+  escrowBalance: 96,
+  requiredScore: 104,
+  verificationScore: 105,
+  scoreSubmissions: 106,
+  retentionEndTick: 108,
+  isActive: 112,
+  isVerified: 113,
+  isPaid: 114,
+  isRefunded: 115,
+  status: 116,
+  depositTick: 120,
+} as const;
+
+/** getContractState output (input is an EscrowKey): fixed-offset view, reads and writes the underlying bytes in place */
+export class StateResponseView {
+  static readonly SIZE = 128;
+  private readonly view: DataView;
+
+  constructor(readonly bytes: Uint8Array) {
+    if (bytes.byteLength < 128) {
+      throw new RangeError(`StateResponse needs 128 bytes, got ${bytes.byteLength}`);
+    }
+    this.view = new DataView(bytes.buffer, bytes.byteOffset, 128);
+  }
+
+  /** Zero-filled buffer ready to be populated */
+  static alloc(): StateResponseView {
+    return new StateResponseView(new Uint8Array(128));
+  }
+
+  get brandId(): Uint8Array { return this.bytes.subarray(0, 32); }
+  set brandId(value: Uint8Array) { this.bytes.set(value.subarray(0, 32), 0); }
+  get influencerId(): Uint8Array { return this.bytes.subarray(32, 64); }
+  set influencerId(value: Uint8Array) { this.bytes.set(value.subarray(0, 32), 32); }
+  get oracleId(): Uint8Array { return this.bytes.subarray(64, 96); }
+  set oracleId(value: Uint8Array) { this.bytes.set(value.subarray(0, 32), 64); }
+  get escrowBalance(): bigint { return this.view.getBigInt64(96, true); }
+  set escrowBalance(value: bigint) { this.view.setBigInt64(96, value, true); }
+  get requiredScore(): number { return this.view.getUint8(104); }
+  set requiredScore(value: number) { this.view.setUint8(104, value); }
+  get verificationScore(): number { return this.view.getUint8(105); }
+  set verificationScore(value: number) { this.view.setUint8(105, value); }
+  get scoreSubmissions(): number { return this.view.getUint8(106); }
+  set scoreSubmissions(value: number) { this.view.setUint8(106, value); }
+  get retentionEndTick(): number { return this.view.getUint32(108, true); }
+  set retentionEndTick(value: number) { this.view.setUint32(108, value, true); }
+  get isActive(): boolean { return this.view.getUint8(112) !== 0; }
+  set isActive(value: boolean) { this.view.setUint8(112, value ? 1 : 0); }
+  get isVerified(): boolean { return this.view.getUint8(113) !== 0; }
+  set isVerified(value: boolean) { this.view.setUint8(113, value ? 1 : 0); }
+  get isPaid(): boolean { return this.view.getUint8(114) !== 0; }
+  set isPaid(value: boolean) { this.view.setUint8(114, value ? 1 : 0); }
+  get isRefunded(): boolean { return this.view.getUint8(115) !== 0; }
+  set isRefunded(value: boolean) { this.view.setUint8(115, value ? 1 : 0); }
+  get status(): EscrowStatus { return this.view.getUint8(116); }
+  set status(value: EscrowStatus) { this.view.setUint8(116, value); }
+  get depositTick(): number { return this.view.getUint32(120, true); }
+  set depositTick(value: number) { this.view.setUint32(120, value, true); }
+}
+
+/** getEscrowsPage input: byte offsets */
+export const EscrowPageInputLayout = {
+  size: 48,
+  party: 0,
+  cursor: 32,
+  minSettleTick: 36,
+  maxSettleTick: 40,
+  status: 44,
+  partyFilter: 45,
+} as const;
+
+/** getEscrowsPage input: fixed-offset view, reads and writes the underlying bytes in place */
+export class EscrowPageInputView {
+  static readonly SIZE = 48;
+  private readonly view: DataView;
+
+  constructor(readonly bytes: Uint8Array) {
+    if (bytes.byteLength < 48) {
+      throw new RangeError(`EscrowPageInput needs 48 bytes, got ${bytes.byteLength}`);
+    }
+    this.view = new DataView(bytes.buffer, bytes.byteOffset, 48);
+  }
+
+  /** Zero-filled buffer ready to be populated */
+  static alloc(): EscrowPageInputView {
+    return new EscrowPageInputView(new Uint8Array(48));
+  }
+
+  get party(): Uint8Array { return this.bytes.subarray(0, 32); }
+  set party(value: Uint8Array) { this.bytes.set(value.subarray(0, 32), 0); }
+  get cursor(): number { return this.view.getUint32(32, true); }
+  set cursor(value: number) { this.view.setUint32(32, value, true); }
+  get minSettleTick(): number { return this.view.getUint32(36, true); }
+  set minSettleTick(value: number) { this.view.setUint32(36, value, true); }
+  get maxSettleTick(): number { return this.view.getUint32(40, true); }
+  set maxSettleTick(value: number) { this.view.setUint32(40, value, true); }
+  get status(): number { return this.view.getUint8(44); }
+  set status(value: number) { this.view.setUint8(44, value); }
+  get partyFilter(): EscrowPartyFilter { return this.view.getUint8(45); }
+  set partyFilter(value: EscrowPartyFilter) { this.view.setUint8(45, value); }
+}
+
+/** One escrow in a getEscrowsPage response: byte offsets */
+export const EscrowPageEntryLayout = {
+  size: 104,
+  key: 0,
+  escrowBalance: 72,
+  slot: 80,
+  retentionEndTick: 84,
+  settleTick: 88,
+  status: 92,
+  requiredScore: 93,
+  verificationScore: 94,
+  depositTick: 96,
+} as const;
+
+/** One escrow in a getEscrowsPage response: fixed-offset view, reads and writes the underlying bytes in place */
+export class EscrowPageEntryView {
+  static readonly SIZE = 104;
+  private readonly view: DataView;
+
+  constructor(readonly bytes: Uint8Array) {
+    if (bytes.byteLength < 104) {
+      throw new RangeError(`EscrowPageEntry needs 104 bytes, got ${bytes.byteLength}`);
+    }
+    this.view = new DataView(bytes.buffer, bytes.byteOffset, 104);
+  }
+
+  /** Zero-filled buffer ready to be populated */
+  static alloc(): EscrowPageEntryView {
+    return new EscrowPageEntryView(new Uint8Array(104));
+  }
+
+  get key(): EscrowKeyView { return new EscrowKeyView(this.bytes.subarray(0, 72)); }
+  get escrowBalance(): bigint { return this.view.getBigInt64(72, true); }
+  set escrowBalance(value: bigint) { this.view.setBigInt64(72, value, true); }
+  get slot(): number { return this.view.getUint32(80, true); }
+  set slot(value: number) { this.view.setUint32(80, value, true); }
+  get retentionEndTick(): number { return this.view.getUint32(84, true); }
+  set retentionEndTick(value: number) { this.view.setUint32(84, value, true); }
+  get settleTick(): number { return this.view.getUint32(88, true); }
+  set settleTick(value: number) { this.view.setUint32(88, value, true); }
+  get status(): EscrowStatus { return this.view.getUint8(92); }
+  set status(value: EscrowStatus) { this.view.setUint8(92, value); }
+  get requiredScore(): number { return this.view.getUint8(93); }
+  set requiredScore(value: number) { this.view.setUint8(93, value); }
+  get verificationScore(): number { return this.view.getUint8(94); }
+  set verificationScore(value: number) { this.view.setUint8(94, value); }
+  get depositTick(): number { return this.view.getUint32(96, true); }
+  set depositTick(value: number) { this.view.setUint32(96, value, true); }
+}
+
+/** getEscrowsPage output: byte offsets */
+export const EscrowPageOutputLayout = {
+  size: 1672,
+  count: 0,
+  nextCursor: 4,
+  entries: 8,
+} as const;
+
+/** getEscrowsPage output: fixed-offset view, reads and writes the underlying bytes in place */
+export class EscrowPageOutputView {
+  static readonly SIZE = 1672;
+  private readonly view: DataView;
+
+  constructor(readonly bytes: Uint8Array) {
+    if (bytes.byteLength < 1672) {
+      throw new RangeError(`EscrowPageOutput needs 1672 bytes, got ${bytes.byteLength}`);
+    }
+    this.view = new DataView(bytes.buffer, bytes.byteOffset, 1672);
+  }
+
+  /** Zero-filled buffer ready to be populated */
+  static alloc(): EscrowPageOutputView {
+    return new EscrowPageOutputView(new Uint8Array(1672));
+  }
+
+  get count(): number { return this.view.getUint32(0, true); }
+  set count(value: number) { this.view.setUint32(0, value, true); }
+  get nextCursor(): number { return this.view.getUint32(4, true); }
+  set nextCursor(value: number) { this.view.setUint32(4, value, true); }
+  entriesAt(index: number): EscrowPageEntryView {
+    if (index < 0 || index >= 16) {
+      throw new RangeError(`entries index ${index} out of range`);
+    }
+    const offset = 8 + index * 104;
+    return new EscrowPageEntryView(this.bytes.subarray(offset, offset + 104));
+  }
+}
+
+/** One event in the contract's event ring: byte offsets */
+export const EscrowEventLayout = {
+  size: 32,
+  sequence: 0,
+  amount: 8,
+  slot: 16,
+  tick: 20,
+  kind: 24,
+  score: 25,
+  status: 26,
+} as const;
+
+/** One event in the contract's event ring: fixed-offset view, reads and writes the underlying bytes in place */
+export class EscrowEventView {
+  static readonly SIZE = 32;
+  private readonly view: DataView;
+
+  constructor(readonly bytes: Uint8Array) {
+    if (bytes.byteLength < 32) {
+      throw new RangeError(`EscrowEvent needs 32 bytes, got ${bytes.byteLength}`);
+    }
+    this.view = new DataView(bytes.buffer, bytes.byteOffset, 32);
+  }
+
+  /** Zero-filled buffer ready to be populated */
+  static alloc(): EscrowEventView {
+    return new EscrowEventView(new Uint8Array(32));
+  }
+
+  get sequence(): bigint { return this.view.getBigUint64(0, true); }
+  set sequence(value: bigint) { this.view.setBigUint64(0, value, true); }
+  get amount(): bigint { return this.view.getBigInt64(8, true); }
+  set amount(value: bigint) { this.view.setBigInt64(8, value, true); }
+  get slot(): number { return this.view.getUint32(16, true); }
+  set slot(value: number) { this.view.setUint32(16, value, true); }
+  get tick(): number { return this.view.getUint32(20, true); }
+  set tick(value: number) { this.view.setUint32(20, value, true); }
+  get kind(): EscrowEventKind { return this.view.getUint8(24); }
+  set kind(value: EscrowEventKind) { this.view.setUint8(24, value); }
+  get score(): number { return this.view.getUint8(25); }
+  set score(value: number) { this.view.setUint8(25, value); }
+  get status(): EscrowStatus { return this.view.getUint8(26); }
+  set status(value: EscrowStatus) { this.view.setUint8(26, value); }
+}
+
+/** getEventsSince input: byte offsets */
+export const EventsInputLayout = {
+  size: 8,
+  afterSequence: 0,
+} as const;
+
+/** getEventsSince input: fixed-offset view, reads and writes the underlying bytes in place */
+export class EventsInputView {
+  static readonly SIZE = 8;
+  private readonly view: DataView;
+
+  constructor(readonly bytes: Uint8Array) {
+    if (bytes.byteLength < 8) {
+      throw new RangeError(`EventsInput needs 8 bytes, got ${bytes.byteLength}`);
+    }
+    this.view = new DataView(bytes.buffer, bytes.byteOffset, 8);
+  }
+
+  /** Zero-filled buffer ready to be populated */
+  static alloc(): EventsInputView {
+    return new EventsInputView(new Uint8Array(8));
+  }
+
+  get afterSequence(): bigint { return this.view.getBigUint64(0, true); }
+  set afterSequence(value: bigint) { this.view.setBigUint64(0, value, true); }
+}
+
+/** getEventsSince output: byte offsets */
+export const EventsOutputLayout = {
+  size: 1048,
+  oldestSequence: 0,
+  latestSequence: 8,
+  count: 16,
+  events: 24,
+} as const;
+
+/** getEventsSince output: fixed-offset view, reads and writes the underlying bytes in place */
+export class EventsOutputView {
+  static readonly SIZE = 1048;
+  private readonly view: DataView;
+
+  constructor(readonly bytes: Uint8Array) {
+    if (bytes.byteLength < 1048) {
+      throw new RangeError(`EventsOutput needs 1048 bytes, got ${bytes.byteLength}`);
+    }
+    this.view = new DataView(bytes.buffer, bytes.byteOffset, 1048);
+  }
+
+  /** Zero-filled buffer ready to be populated */
+  static alloc(): EventsOutputView {
+    return new EventsOutputView(new Uint8Array(1048));
+  }
+
+  get oldestSequence(): bigint { return this.view.getBigUint64(0, true); }
+  set oldestSequence(value: bigint) { this.view.setBigUint64(0, value, true); }
+  get latestSequence(): bigint { return this.view.getBigUint64(8, true); }
+  set latestSequence(value: bigint) { this.view.setBigUint64(8, value, true); }
+  get count(): number { return this.view.getUint32(16, true); }
+  set count(value: number) { this.view.setUint32(16, value, true); }
+  eventsAt(index: number): EscrowEventView {
+    if (index < 0 || index >= 32) {
+      throw new RangeError(`events index ${index} out of range`);
+    }
+    const offset = 24 + index * 32;
+    return new EscrowEventView(this.bytes.subarray(offset, offset + 32));
+  }
+}
+
+/** getAggregates output: byte offsets */
+export const AggregatesOutputLayout = {
+  size: 80,
+  lockedBalance: 0,
+  lockedFees: 8,
+  accruedFees: 16,
+  sweptFees: 24,
+  totalDeposited: 32,
+  totalReleased: 40,
+  totalRefunded: 48,
+  pendingCount: 56,
+  verifiedCount: 60,
+  paidCount: 64,
+  refundedCount: 68,
+  availableSlots: 72,
+  queuedSettlements: 76,
+} as const;
+
+/** getAggregates output: fixed-offset view, reads and writes the underlying bytes in place */
+export class AggregatesOutputView {
+  static readonly SIZE = 80;
+  private readonly view: DataView;
+
+  constructor(readonly bytes: Uint8Array) {
+    if (bytes.byteLength < 80) {
+      throw new RangeError(`AggregatesOutput needs 80 bytes, got ${bytes.byteLength}`);
+    }
+    this.view = new DataView(bytes.buffer, bytes.byteOffset, 80);
+  }
+
+  /** Zero-filled buffer ready to be populated */
+  static alloc(): AggregatesOutputView {
+    return new AggregatesOutputView(new Uint8Array(80));
+  }
+
+  get lockedBalance(): bigint { return this.view.getBigInt64(0, true); }
+  set lockedBalance(value: bigint) { this.view.setBigInt64(0, value, true); }
+  get lockedFees(): bigint { return this.view.getBigInt64(8, true); }
+  set lockedFees(value: bigint) { this.view.setBigInt64(8, value, true); }
+  get accruedFees(): bigint { return this.view.getBigInt64(16, true); }
+  set accruedFees(value: bigint) { this.view.setBigInt64(16, value, true); }
+  get sweptFees(): bigint { return this.view.getBigInt64(24, true); }
+  set sweptFees(value: bigint) { this.view.setBigInt64(24, value, true); }
+  get totalDeposited(): bigint { return this.view.getBigInt64(32, true); }
+  set totalDeposited(value: bigint) { this.view.setBigInt64(32, value, true); }
+  get totalReleased(): bigint { return this.view.getBigInt64(40, true); }
+  set totalReleased(value: bigint) { this.view.setBigInt64(40, value, true); }
+  get totalRefunded(): bigint { return this.view.getBigInt64(48, true); }
+  set totalRefunded(value: bigint) { this.view.setBigInt64(48, value, true); }
+  get pendingCount(): number { return this.view.getUint32(56, true); }
+  set pendingCount(value: number) { this.view.setUint32(56, value, true); }
+  get verifiedCount(): number { return this.view.getUint32(60, true); }
+  set verifiedCount(value: number) { this.view.setUint32(60, value, true); }
+  get paidCount(): number { return this.view.getUint32(64, true); }
+  set paidCount(value: number) { this.view.setUint32(64, value, true); }
+  get refundedCount(): number { return this.view.getUint32(68, true); }
+  set refundedCount(value: number) { this.view.setUint32(68, value, true); }
+  get availableSlots(): number { return this.view.getUint32(72, true); }
+  set availableSlots(value: number) { this.view.setUint32(72, value, true); }
+  get queuedSettlements(): number { return this.view.getUint32(76, true); }
+  set queuedSettlements(value: number) { this.view.setUint32(76, value, true); }
+}
@@ -8,13 +8,23 @@ import { Config } from './config';
 import { AIClient } from './aiClient';
 import { QubicClient } from './qubicClient';
 import { TransactionBuilder } from './transactionBuilder';
-import { VerificationRequest, OracleState } from './types';
+import { InvalidRequestError, QueueFullError, VerificationPipeline } from './verificationPipeline';
+import { StateStore } from './stateStore';
+import { CONTENT_TYPE, registry } from './metrics';
+import { VerificationRequest, OracleState, PersistedJob } from './types';
+import { EscrowEventKind, EscrowStatus, EVENT_PAGE_SIZE } from './escrowWire';
+
+// Event pages read per monitoring cycle before yielding to the next cycle
+const MAX_EVENT_PAGES_PER_CYCLE = 8;
 
 class OracleAgent {
   private aiClient: AIClient;
   private qubicClient: QubicClient;
   private txBuilder: TransactionBuilder;
+  private pipeline: VerificationPipeline;
   private state: OracleState;
+  private store: StateStore;
+  private recoveredJobs: PersistedJob[];
   private app: express.Application;
   private isRunning: boolean = false;
 
@@ -23,16 +33,63 @@ class OracleAgent {
     this.qubicClient = new QubicClient();
     this.txBuilder = new TransactionBuilder();
     
-    this.state = {
-      lastProcessedTick: 0,
-      pendingVerifications: new Map(),
-      completedVerifications: new Map()
-    };
+    // State survives restarts; the store updates it as changes are logged
+    this.store = new StateStore(Config.ORACLE.stateDir, Config.ORACLE.snapshotEvery);
+    const loadStarted = Date.now();
+    const recovered = this.store.load();
+    this.state = recovered.state;
+    this.recoveredJobs = recovered.jobs;
+    if (this.state.lastProcessedTick > 0) {
+      console.log(`[Oracle] Recovered state from ${Config.ORACLE.stateDir} in ${Date.now() - loadStarted}ms ` +
+        `(${recovered.records} log records, ${recovered.jobs.length} unfinished jobs)`);
+    }
+
+    this.pipeline = new VerificationPipeline(this.aiClient, this.qubicClient, this.txBuilder, {
+      contractId: Config.QUBIC.contractId,
+      aiConcurrency: Config.ORACLE.aiConcurrency,
+      aiBatchSize: Config.ORACLE.aiBatchSize,
+      submitConcurrency: Config.ORACLE.submitConcurrency,
+      maxQueueDepth: Config.ORACLE.maxQueueDepth,
+      batchSize: Config.ORACLE.batchSize,
+      confirmTimeoutMs: 60000,
+      pendingDepositTick: slot => this.state.pendingEscrows.get(slot),
+      onConfirmed: (request, aiResult) => this.store.recordCompleted(request.postUrl, aiResult),
+      journal: this.store
+    });
 
+    this.registerMetrics();
     this.app = express();
     this.setupExpress();
   }
 
+  /**
+   * Queue depths and totals, read from the pipeline and state on each scrape
+   */
+  private registerMetrics(): void {
+    registry.gauge('oracle_queue_depth', 'Verification requests in each pipeline stage', () => {
+      const stats = this.pipeline.stats();
+      return (['awaitingScore', 'scoring', 'awaitingSubmission', 'submitting', 'confirming'] as const)
+        .map(stage => ({ labels: { stage }, value: stats[stage] }));
+    });
+    registry.counterCallback('oracle_verifications_total', 'Verification requests finished, by outcome', () => {
+      const stats = this.pipeline.stats();
+      return [
+        { labels: { outcome: 'completed' }, value: stats.completed },
+        { labels: { outcome: 'failed' }, value: stats.failed },
+        { labels: { outcome: 'rejected' }, value: stats.rejected }
+      ];
+    });
+    registry.gauge('oracle_pending_confirmations', 'Transactions the tick watcher is waiting on',
+      () => this.qubicClient.pendingConfirmations());
+    registry.gauge('oracle_pending_escrows', 'Escrows awaiting a score', () => this.state.pendingEscrows.size);
+    registry.gauge('oracle_last_processed_tick', 'Last tick the monitoring loop processed',
+      () => this.state.lastProcessedTick);
+    registry.counterCallback('oracle_rpc_batches_total', 'Batched RPC round-trips sent',
+      () => this.qubicClient.rpcStats().batchesSent);
+    registry.counterCallback('oracle_rpc_batched_calls_total', 'RPC calls carried in batches',
+      () => this.qubicClient.rpcStats().callsBatched);
+  }
+
   /**
    * Setup Express server with API endpoints
    */
@@ -78,6 +135,17 @@ class OracleAgent {
         
         res.json(result);
       } catch (error: any) {
+        if (error instanceof InvalidRequestError) {
+          return res.status(400).json({ error: error.message });
+        }
+        if (error instanceof QueueFullError) {
+          // Backpressure: the caller should retry later
+          return res.status(503).json({
+            error: 'Verification queue full',
+            details: error.message,
+            queue: this.pipeline.stats()
+          });
+        }
         console.error('[Oracle] Verification error:', error);
         res.status(500).json({ 
           error: 'Verification failed',
@@ -94,7 +162,11 @@ class OracleAgent {
         res.json({
           lastProcessedTick: this.state.lastProcessedTick,
           currentTick,
-          pendingCount: this.state.pendingVerifications.size,
+          pendingEscrowCount: this.state.pendingEscrows.size,
+          pendingConfirmations: this.qubicClient.pendingConfirmations(),
+          queue: this.pipeline.stats(),
+          rpc: this.qubicClient.rpcStats(),
+          lastEventSequence: this.state.lastEventSequence.toString(),
           completedCount: this.state.completedVerifications.size,
           rpcEndpoint: this.qubicClient.getRpcEndpoint(),
           oraclePublicKey: this.txBuilder.getOraclePublicKey()
@@ -107,11 +179,19 @@ class OracleAgent {
       }
     });
 
+    // Prometheus metrics
+    this.app.get('/metrics', (req, res) => {
+      res.type(CONTENT_TYPE).send(registry.render());
+    });
+
     // Get network info
     this.app.get('/network', async (req, res) => {
       try {
-        const tickInfo = await this.qubicClient.getTickInfo();
-        const status = await this.qubicClient.getNetworkStatus();
+        // Issued together so they share one RPC round-trip
+        const [tickInfo, status] = await Promise.all([
+          this.qubicClient.getTickInfo(),
+          this.qubicClient.getNetworkStatus()
+        ]);
         
         res.json({
           currentTick: tickInfo.tick,
@@ -194,9 +274,17 @@ class OracleAgent {
       console.log('[Oracle] ✓ Successfully connected to Qubic network');
       console.log();
 
-      // Get initial tick
-      this.state.lastProcessedTick = await this.qubicClient.getCurrentTick();
-      console.log(`[Oracle] Starting from tick: ${this.state.lastProcessedTick}`);
+      // Resume where the last run stopped, or start at the current tick
+      if (this.state.lastProcessedTick > 0) {
+        console.log(`[Oracle] Resuming from tick: ${this.state.lastProcessedTick}`);
+      } else {
+        this.store.recordTick(await this.qubicClient.getCurrentTick());
+        console.log(`[Oracle] Starting from tick: ${this.state.lastProcessedTick}`);
+      }
+      if (this.recoveredJobs.length > 0) {
+        this.pipeline.resume(this.recoveredJobs);
+        this.recoveredJobs = [];
+      }
       console.log();
 
       // Display Oracle identity
@@ -213,6 +301,7 @@ class OracleAgent {
         console.log(`[Oracle]   POST /verify     - Manual verification`);
         console.log(`[Oracle]   GET  /state      - Oracle state`);
         console.log(`[Oracle]   GET  /network    - Network info`);
+        console.log(`[Oracle]   GET  /metrics    - Prometheus metrics`);
         console.log(`[Oracle]   GET  /balance/:address - Get balance`);
         console.log();
       });
@@ -255,7 +344,10 @@ class OracleAgent {
 
   /**
    * Single monitoring cycle
-   * In production, this would check for new escrow contracts requiring verification
+   * Records the current tick and, with CONTRACT_INDEX set, syncs the escrows
+   * awaiting a score from the contract's event ring. submit() checks
+   * request slots against that set, and the set feeds /state and the
+   * pending-escrow metric; requests are processed by the pipeline, not here
    */
   private async monitoringCycle(): Promise<void> {
     try {
@@ -270,13 +362,11 @@ class OracleAgent {
           console.log(`[Oracle] Network advanced ${ticksAdvanced} ticks (now at ${currentTick})`);
         }
         
-        // In production, query contract for new escrows
-        // For now, just update last processed tick
-        this.state.lastProcessedTick = currentTick;
+        this.store.recordTick(currentTick);
         
-        // TODO: Query smart contract for pending verifications
-        // const contractState = await this.qubicClient.getContractState(contractIndex);
-        // Process any pending verifications...
+        if (Config.QUBIC.contractIndex > 0) {
+          await this.syncPendingEscrows();
+        }
       }
     } catch (error: any) {
       // Don't crash on monitoring errors, just log them
@@ -289,125 +379,75 @@ class OracleAgent {
   }
 
   /**
-   * Process a verification request (REAL IMPLEMENTATION)
+   * Bring the pending-escrow work set up to date
+   * Applies only the events since the last cycle; the contract's pending list
+   * is re-read in full on the first cycle or when the event ring has moved
+   * past lastEventSequence
    */
-  async processVerification(request: VerificationRequest): Promise<any> {
-    console.log('─────────────────────────────────────────');
-    console.log(`[Oracle] Processing Verification`);
-    console.log(`[Oracle] Post URL: ${request.postUrl}`);
-    console.log(`[Oracle] Scenario: ${request.scenario || 'default'}`);
-    console.log('─────────────────────────────────────────');
-
-    try {
-      // Step 1: Call AI service for verification
-      console.log('[Oracle] Step 1/6: Requesting AI verification...');
-      const aiResult = await this.aiClient.verifyPost(request);
-      
-      console.log(`[Oracle] ✓ AI Analysis complete`);
-      console.log(`[Oracle]   Overall Score: ${aiResult.overall_score}/100`);
-      console.log(`[Oracle]   Recommendation: ${aiResult.recommendation}`);
-      console.log(`[Oracle]   Confidence: ${aiResult.confidence}`);
-      console.log();
-
-      // Step 2: Get current network tick
-      console.log('[Oracle] Step 2/6: Getting current network tick...');
-      const currentTick = await this.qubicClient.getCurrentTick();
-      console.log(`[Oracle] ✓ Current tick: ${currentTick}`);
-      console.log();
-
-      // Step 3: Validate transaction parameters
-      console.log('[Oracle] Step 3/6: Validating transaction parameters...');
-      const validation = this.txBuilder.validateTransactionParams(
-        Config.QUBIC.contractId,
-        aiResult.overall_score,
-        currentTick
-      );
-
-      if (!validation.valid) {
-        throw new Error(`Invalid transaction parameters: ${validation.errors.join(', ')}`);
+  private async syncPendingEscrows(): Promise<void> {
+    const contractIndex = Config.QUBIC.contractIndex;
+    const escrows = this.state.pendingEscrows;
+    let afterSequence = this.state.lastEventSequence;
+    let needsResync = afterSequence === BigInt(0);
+    let newCount = 0;
+
+    for (let pageNumber = 0; pageNumber < MAX_EVENT_PAGES_PER_CYCLE; pageNumber++) {
+      const events = await this.qubicClient.getEventsSince(contractIndex, afterSequence);
+      if (!events) {
+        return;
       }
-      console.log('[Oracle] ✓ Transaction parameters valid');
-      console.log();
-
-      // Step 4: Build and sign transaction
-      console.log('[Oracle] Step 4/6: Building and signing transaction...');
-      const txResult = await this.txBuilder.buildSetVerificationScoreTransaction(
-        Config.QUBIC.contractId,
-        aiResult.overall_score,
-        currentTick
-      );
-      console.log(`[Oracle] ✓ Transaction built`);
-      console.log(`[Oracle]   Target Tick: ${txResult.targetTick}`);
-      console.log(`[Oracle]   TX ID: ${txResult.transactionId}`);
-      console.log();
-
-      // Step 5: Broadcast to network (FIXED - now passing encoded string)
-      console.log('[Oracle] Step 5/6: Broadcasting transaction to network...');
-      const txId = await this.qubicClient.broadcastTransaction(txResult.encodedTransaction);
-      console.log(`[Oracle] ✓ Transaction broadcasted`);
-      console.log(`[Oracle]   Transaction ID: ${txId}`);
-      console.log();
-
-      // Step 6: Wait for confirmation
-      console.log('[Oracle] Step 6/6: Waiting for transaction confirmation...');
-      console.log(`[Oracle] Target tick: ${txResult.targetTick}, Current tick: ${currentTick}`);
-      
-      const confirmed = await this.qubicClient.waitForConfirmation(
-        txId,
-        txResult.targetTick,
-        60000 // 60 second timeout
-      );
 
-      if (confirmed) {
-        console.log();
-        console.log('[Oracle] ✓ VERIFICATION COMPLETE');
-        console.log(`[Oracle]   Score ${aiResult.overall_score} successfully submitted to blockchain`);
-        console.log(`[Oracle]   Transaction confirmed at tick ${txResult.targetTick}`);
-        
-        // Store result
-        this.state.completedVerifications.set(request.postUrl, aiResult);
-      } else {
-        console.error();
-        console.error('[Oracle] ✗ Transaction confirmation failed');
-        console.error('[Oracle] The transaction may still be pending or was rejected');
+      if (events.oldestSequence > afterSequence + BigInt(1)) {
+        needsResync = true;
       }
 
-      console.log('─────────────────────────────────────────');
-      console.log();
-
-      return {
-        success: confirmed,
-        transactionId: txId,
-        targetTick: txResult.targetTick,
-        score: aiResult.overall_score,
-        recommendation: aiResult.recommendation,
-        confidence: aiResult.confidence,
-        aiResult: {
-          overall_score: aiResult.overall_score,
-          passed: aiResult.passed,
-          recommendation: aiResult.recommendation,
-          confidence: aiResult.confidence,
-          fraud_flags: aiResult.fraud_flags,
-          summary: aiResult.summary
-        },
-        transaction: {
-          id: txId,
-          tick: txResult.targetTick,
-          inputType: txResult.inputType,
-          confirmed
+      for (let i = 0; i < events.count; i++) {
+        const event = events.eventsAt(i);
+        switch (event.kind) {
+          case EscrowEventKind.DEPOSITED:
+            escrows.set(event.slot, event.tick);  // Emitted in the deposit's tick
+            newCount++;
+            break;
+          case EscrowEventKind.VERIFIED:
+          case EscrowEventKind.RELEASED:
+          case EscrowEventKind.REFUNDED:
+            escrows.delete(event.slot);
+            break;
         }
-      };
+        afterSequence = event.sequence;
+      }
 
-    } catch (error: any) {
-      console.error();
-      console.error('[Oracle] ✗ Verification processing failed');
-      console.error(`[Oracle] Error: ${error.message}`);
-      console.error('─────────────────────────────────────────');
-      console.error();
-      throw error;
+      if (events.count < EVENT_PAGE_SIZE) {
+        break;
+      }
+    }
+
+    if (needsResync) {
+      const pending = await this.qubicClient.getEscrowsByStatus(contractIndex, EscrowStatus.PENDING);
+      escrows.clear();
+      pending.forEach(escrow => escrows.set(escrow.slot, escrow.depositTick));
+      console.log(`[Oracle] Resynced pending escrows: ${escrows.size} awaiting verification`);
+    } else if (newCount > 0) {
+      console.log(`[Oracle] ${newCount} new escrow(s) awaiting verification (${escrows.size} pending)`);
+    }
+    if (needsResync || afterSequence !== this.state.lastEventSequence) {
+      this.store.recordEscrows(afterSequence, escrows);
     }
   }
 
+  /**
+   * Process a verification request (REAL IMPLEMENTATION)
+   * Queues it on the pipeline: AI scoring, then batched chain submission,
+   * then confirmation. Resolves with the submission result; rejects with
+   * QueueFullError when the pipeline is at maxQueueDepth and with
+   * InvalidRequestError when the request names no slot awaiting a score in
+   * the synced pending set
+   */
+  async processVerification(request: VerificationRequest): Promise<any> {
+    console.log(`[Oracle] Queueing verification: ${request.postUrl} (scenario: ${request.scenario || 'default'})`);
+    return this.pipeline.submit(request);
+  }
+
   /**
    * Stop the oracle service
    */
@@ -415,6 +455,8 @@ class OracleAgent {
     console.log();
     console.log('[Oracle] Stopping oracle agent...');
     this.isRunning = false;
+    this.store.close();
+    console.log('[Oracle] ✓ State saved to ' + Config.ORACLE.stateDir);
     console.log('[Oracle] ✓ Oracle agent stopped gracefully');
   }
 
@@ -0,0 +1,195 @@
+/**
+ * Metrics
+ * Latency histograms and counters, rendered in the Prometheus text format
+ *
+ * Histograms share fixed bucket bounds from 100us to ~105s in steps of
+ * sqrt(2) (HDR-style log buckets): a value's bucket is computed from its
+ * logarithm, so recording is a few arithmetic operations and an increment.
+ *
+ * backend/oracle-agent/src/metrics.ts and backend/qubic-rpc-proxy/src/metrics.ts
+ * are identical copies (each package compiles only its own src/). Change
+ * both together; `npm run check:metrics` in either package compares them.
+ */
+
+const MIN_BOUND = 0.0001;
+const STEPS_PER_DOUBLING = 2;
+const BUCKET_COUNT = 41;
+const LE_LABELS = Array.from({ length: BUCKET_COUNT }, (_, i) =>
+  `le="${formatBound(MIN_BOUND * Math.pow(2, i / STEPS_PER_DOUBLING))}"`
+).concat(['le="+Inf"']);
+
+type Labels = Record<string, string | number>;
+type Sample = number | Array<{ labels: Labels; value: number }>;
+
+function formatBound(bound: number): string {
+  return parseFloat(bound.toPrecision(6)).toString();
+}
+
+function bucketIndex(seconds: number): number {
+  if (seconds <= MIN_BOUND) {
+    return 0;
+  }
+  const index = Math.ceil(STEPS_PER_DOUBLING * Math.log2(seconds / MIN_BOUND) - 1e-9);
+  return Math.min(index, BUCKET_COUNT);
+}
+
+function formatLabels(labels: Labels, extra?: string): string {
+  const pairs = Object.keys(labels).map(name =>
+    `${name}="${String(labels[name]).replace(/\\/g, '\\\\').replace(/\n/g, '\\n').replace(/"/g, '\\"')}"`
+  );
+  if (extra) {
+    pairs.push(extra);
+  }
+  return pairs.length > 0 ? `{${pairs.join(',')}}` : '';
+}
+
+interface Metric {
+  name: string;
+  help: string;
+  type: 'histogram' | 'counter' | 'gauge';
+  render(): string[];
+}
+
+class HistogramSeries {
+  buckets: number[] = new Array(BUCKET_COUNT + 1).fill(0);
+  sum: number = 0;
+  count: number = 0;
+
+  observe(seconds: number): void {
+    this.buckets[bucketIndex(seconds)]++;
+    this.sum += seconds;
+    this.count++;
+  }
+}
+
+export class Histogram implements Metric {
+  readonly type = 'histogram';
+  private series: Map<string, { labels: Labels; series: HistogramSeries }> = new Map();
+
+  constructor(readonly name: string, readonly help: string) {}
+
+  /** Record a duration in seconds */
+  observe(seconds: number, labels: Labels = {}): void {
+    const key = JSON.stringify(labels);
+    let entry = this.series.get(key);
+    if (!entry) {
+      entry = { labels, series: new HistogramSeries() };
+      this.series.set(key, entry);
+    }
+    entry.series.observe(seconds);
+  }
+
+  /** Start a timer; calling the result records the elapsed time */
+  startTimer(labels: Labels = {}): () => number {
+    const started = process.hrtime.bigint();
+    return () => {
+      const seconds = Number(process.hrtime.bigint() - started) / 1e9;
+      this.observe(seconds, labels);
+      return seconds;
+    };
+  }
+
+  /** Time a promise */
+  async time<T>(labels: Labels, work: () => Promise<T>): Promise<T> {
+    const stop = this.startTimer(labels);
+    try {
+      return await work();
+    } finally {
+      stop();
+    }
+  }
+
+  render(): string[] {
+    const lines: string[] = [];
+    for (const { labels, series } of this.series.values()) {
+      let cumulative = 0;
+      series.buckets.forEach((count, i) => {
+        cumulative += count;
+        lines.push(`${this.name}_bucket${formatLabels(labels, LE_LABELS[i])} ${cumulative}`);
+      });
+      lines.push(`${this.name}_sum${formatLabels(labels)} ${series.sum}`);
+      lines.push(`${this.name}_count${formatLabels(labels)} ${series.count}`);
+    }
+    return lines;
+  }
+}
+
+export class Counter implements Metric {
+  readonly type = 'counter';
+  private values: Map<string, { labels: Labels; value: number }> = new Map();
+
+  constructor(readonly name: string, readonly help: string) {}
+
+  inc(labels: Labels = {}, amount: number = 1): void {
+    const key = JSON.stringify(labels);
+    const entry = this.values.get(key);
+    if (entry) {
+      entry.value += amount;
+    } else {
+      this.values.set(key, { labels, value: amount });
+    }
+  }
+
+  render(): string[] {
+    return Array.from(this.values.values(), ({ labels, value }) => `${this.name}${formatLabels(labels)} ${value}`);
+  }
+}
+
+/** Gauge or counter whose value is read when metrics are rendered */
+class CallbackMetric implements Metric {
+  constructor(
+    readonly name: string,
+    readonly help: string,
+    readonly type: 'gauge' | 'counter',
+    private read: () => Sample
+  ) {}
+
+  render(): string[] {
+    const sample = this.read();
+    if (typeof sample === 'number') {
+      return [`${this.name} ${sample}`];
+    }
+    return sample.map(({ labels, value }) => `${this.name}${formatLabels(labels)} ${value}`);
+  }
+}
+
+export class MetricsRegistry {
+  private metrics: Metric[] = [];
+
+  histogram(name: string, help: string): Histogram {
+    return this.add(new Histogram(name, help));
+  }
+
+  counter(name: string, help: string): Counter {
+    return this.add(new Counter(name, help));
+  }
+
+  gauge(name: string, help: string, read: () => Sample): void {
+    this.add(new CallbackMetric(name, help, 'gauge', read));
+  }
+
+  counterCallback(name: string, help: string, read: () => Sample): void {
+    this.add(new CallbackMetric(name, help, 'counter', read));
+  }
+
+  /** Prometheus text exposition format (version 0.0.4) */
+  render(): string {
+    const lines: string[] = [];
+    for (const metric of this.metrics) {
+      lines.push(`# HELP ${metric.name} ${metric.help}`);
+      lines.push(`# TYPE ${metric.name} ${metric.type}`);
+      lines.push(...metric.render());
+    }
+    return lines.join('\n') + '\n';
+  }
+
+  private add<M extends Metric>(metric: M): M {
+    this.metrics.push(metric);
+    return metric;
+  }
+}
+
+export const CONTENT_TYPE = 'text/plain; version=0.0.4';
+
+/** Registry served on this service's /metrics endpoint */
+export const registry = new MetricsRegistry();
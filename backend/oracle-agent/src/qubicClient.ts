@@ -2,9 +2,26 @@
  * Qubic Network Client (REAL RPC IMPLEMENTATION - FIXED)
  * Uses official Qubic RPC endpoints and proper transaction encoding
  */
-import axios from 'axios';
 import { Config } from './config';
-import { TransactionStatus, EscrowContract } from './types';
+import { TransactionStatus } from './types';
+import { TickWatcher } from './tickWatcher';
+import { RpcTransport, RpcResponse } from './rpcTransport';
+import { registry } from './metrics';
+import {
+  AggregatesOutputView,
+  EscrowFunction,
+  EscrowKeyView,
+  EscrowPageEntryView,
+  EscrowPageInputView,
+  EscrowPageOutputView,
+  EscrowStatus,
+  EventsInputView,
+  EventsOutputView,
+  StateResponseView
+} from './escrowWire';
+
+const RPC_CALLS = registry.counter('oracle_rpc_calls_total', 'Qubic RPC calls by client method and outcome');
+const RPC_SECONDS = registry.histogram('oracle_rpc_duration_seconds', 'Qubic RPC call latency by client method');
 
 interface TickInfo {
   tick: number;
@@ -44,20 +61,21 @@ interface NetworkStatus {
 }
 
 export class QubicClient {
-  private rpcClient: any;
+  private rpcClient: RpcTransport;   // Pooled; reads in one event-loop turn share a round-trip
   private contractId: string;
   private connected: boolean = false; // FIXED: Renamed from isConnected
+  private tickWatcher: TickWatcher;   // Shared by every waitForConfirmation call
 
   constructor() {
-    this.rpcClient = axios.create({
+    this.rpcClient = new RpcTransport({
       baseURL: Config.QUBIC.rpcEndpoint,
-      timeout: 15000,
-      headers: {
-        'Content-Type': 'application/json',
-        'Accept': 'application/json'
-      }
+      timeoutMs: 15000,
+      maxSocketsPerHost: Config.QUBIC.rpcMaxSockets,
+      batching: Config.QUBIC.rpcBatching,
+      maxBatchSize: Config.QUBIC.rpcMaxBatchSize
     });
     this.contractId = Config.QUBIC.contractId;
+    this.tickWatcher = new TickWatcher(this, Config.ORACLE.confirmationPollMs);
   }
 
   /**
@@ -66,7 +84,7 @@ export class QubicClient {
    */
   async getCurrentTick(): Promise<number> {
     try {
-      const response = await this.rpcClient.get('/v1/tick-info');
+      const response = await this.call('getCurrentTick', () => this.rpcClient.get('/v1/tick-info'));
       const data = response.data;
       
       if (data?.tickInfo?.tick) {
@@ -92,7 +110,7 @@ export class QubicClient {
    */
   async getTickInfo(): Promise<TickInfo> {
     try {
-      const response = await this.rpcClient.get('/v1/tick-info');
+      const response = await this.call('getTickInfo', () => this.rpcClient.get('/v1/tick-info'));
       return {
         tick: response.data.tickInfo.tick,
         timestamp: response.data.tickInfo.timestamp,
@@ -108,7 +126,7 @@ export class QubicClient {
    */
   async getNetworkStatus(): Promise<NetworkStatus> {
     try {
-      const response = await this.rpcClient.get('/v1/status');
+      const response = await this.call('getNetworkStatus', () => this.rpcClient.get('/v1/status'));
       return response.data;
     } catch (error: any) {
       throw new Error(`Failed to get network status: ${error.message}`);
@@ -127,12 +145,12 @@ export class QubicClient {
     try {
       const requestDataSize = requestData ? Buffer.from(requestData, 'base64').length : 0;
       
-      const response = await this.rpcClient.post('/v1/querySmartContract', {
+      const response = await this.call('querySmartContract', () => this.rpcClient.query('/v1/querySmartContract', {
         contractIndex,
         inputType,
         inputSize: requestDataSize,
         requestData: requestData || ''
-      });
+      }));
 
       if (response.data?.responseData) {
         // Return the base64 encoded response
@@ -147,16 +165,22 @@ export class QubicClient {
   }
 
   /**
-   * Get contract state by querying with empty payload
+   * Get the state of one escrow
+   * Returns a typed view over the response bytes (no field copies), or null
+   * if the query failed or the response is shorter than StateResponse
    */
-  async getContractState(contractIndex: number): Promise<EscrowContract | null> {
+  async getContractState(contractIndex: number, key: EscrowKeyView): Promise<StateResponseView | null> {
     try {
-      const response = await this.querySmartContract(contractIndex, 0, '');
+      const requestData = Buffer.from(key.bytes.buffer, key.bytes.byteOffset, EscrowKeyView.SIZE).toString('base64');
+      const response = await this.querySmartContract(contractIndex, EscrowFunction.GET_CONTRACT_STATE, requestData);
       
       if (response?.responseData) {
-        // Decode base64 response
         const stateData = Buffer.from(response.responseData, 'base64');
-        return this.parseContractState(stateData);
+        if (stateData.length < StateResponseView.SIZE) {
+          console.error(`[Qubic Client] Contract state response too short: ${stateData.length} bytes`);
+          return null;
+        }
+        return new StateResponseView(stateData);
       }
 
       return null;
@@ -166,13 +190,135 @@ export class QubicClient {
     }
   }
 
+  /**
+   * Fetch one page of escrows
+   * Returns a typed view over the response bytes, or null if the query failed
+   */
+  async getEscrowsPage(contractIndex: number, query: EscrowPageInputView): Promise<EscrowPageOutputView | null> {
+    try {
+      const requestData = Buffer.from(query.bytes.buffer, query.bytes.byteOffset, EscrowPageInputView.SIZE).toString('base64');
+      const response = await this.querySmartContract(contractIndex, EscrowFunction.GET_ESCROWS_PAGE, requestData);
+
+      if (response?.responseData) {
+        const pageData = Buffer.from(response.responseData, 'base64');
+        if (pageData.length < EscrowPageOutputView.SIZE) {
+          console.error(`[Qubic Client] Escrow page response too short: ${pageData.length} bytes`);
+          return null;
+        }
+        return new EscrowPageOutputView(pageData);
+      }
+
+      return null;
+    } catch (error: any) {
+      console.error('[Qubic Client] Failed to get escrow page:', error.message);
+      return null;
+    }
+  }
+
+  /**
+   * Fetch contract events newer than a sequence number
+   * Returns a typed view over the response bytes, or null if the query failed
+   */
+  async getEventsSince(contractIndex: number, afterSequence: bigint): Promise<EventsOutputView | null> {
+    try {
+      const query = EventsInputView.alloc();
+      query.afterSequence = afterSequence;
+
+      const requestData = Buffer.from(query.bytes).toString('base64');
+      const response = await this.querySmartContract(contractIndex, EscrowFunction.GET_EVENTS_SINCE, requestData);
+
+      if (response?.responseData) {
+        const eventData = Buffer.from(response.responseData, 'base64');
+        if (eventData.length < EventsOutputView.SIZE) {
+          console.error(`[Qubic Client] Events response too short: ${eventData.length} bytes`);
+          return null;
+        }
+        return new EventsOutputView(eventData);
+      }
+
+      return null;
+    } catch (error: any) {
+      console.error('[Qubic Client] Failed to get events:', error.message);
+      return null;
+    }
+  }
+
+  /**
+   * Fetch contract-wide totals (locked value, counts by status, fees)
+   * Returns a typed view over the response bytes, or null if the query failed
+   */
+  async getAggregates(contractIndex: number): Promise<AggregatesOutputView | null> {
+    try {
+      const response = await this.querySmartContract(contractIndex, EscrowFunction.GET_AGGREGATES, '');
+
+      if (response?.responseData) {
+        const aggregateData = Buffer.from(response.responseData, 'base64');
+        if (aggregateData.length < AggregatesOutputView.SIZE) {
+          console.error(`[Qubic Client] Aggregates response too short: ${aggregateData.length} bytes`);
+          return null;
+        }
+        return new AggregatesOutputView(aggregateData);
+      }
+
+      return null;
+    } catch (error: any) {
+      console.error('[Qubic Client] Failed to get aggregates:', error.message);
+      return null;
+    }
+  }
+
+  /**
+   * Collect the escrows in one status by following the page cursor
+   * Stops after maxPages pages; entries repeated after a cursor restart are dropped
+   */
+  async getEscrowsByStatus(
+    contractIndex: number,
+    status: EscrowStatus,
+    maxPages: number = 16
+  ): Promise<EscrowPageEntryView[]> {
+    const query = EscrowPageInputView.alloc();
+    query.status = status;
+
+    const escrows = new Map<number, EscrowPageEntryView>();
+    for (let pageNumber = 0; pageNumber < maxPages; pageNumber++) {
+      const page = await this.getEscrowsPage(contractIndex, query);
+      if (!page) {
+        break;
+      }
+
+      for (let i = 0; i < page.count; i++) {
+        const entry = page.entriesAt(i);
+        escrows.set(entry.slot, entry);
+      }
+
+      if (page.nextCursor === 0) {
+        break;
+      }
+      query.cursor = page.nextCursor;
+    }
+
+    return Array.from(escrows.values());
+  }
+
+  /**
+   * Build the getContractState key for a campaign
+   * Identities are the 60-character form; campaignNonce is the brand's number
+   */
+  static escrowKey(brandId: string, influencerId: string, campaignNonce: bigint): EscrowKeyView {
+    const key = EscrowKeyView.alloc();
+    key.brandId = identityToPublicKey(brandId);
+    key.influencerId = identityToPublicKey(influencerId);
+    key.campaignNonce = campaignNonce;
+    return key;
+  }
+
   /**
    * Get account balance (REAL)
    * Uses /v1/balances/{identityId} endpoint
    */
   async getBalance(address: string): Promise<number> {
     try {
-      const response = await this.rpcClient.get(`/v1/balances/${address}`);
+      const response = await this.call('getBalance', () => this.rpcClient.get(`/v1/balances/${address}`));
       const balance: Balance = response.data.balance;
       
       // Convert balance string to number (balance is in QU)
@@ -197,9 +343,9 @@ export class QubicClient {
     try {
       console.log('[Qubic Client] Broadcasting transaction to network...');
       
-      const response = await this.rpcClient.post('/v1/broadcast-transaction', {
+      const response = await this.call('broadcastTransaction', () => this.rpcClient.post('/v1/broadcast-transaction', {
         encodedTransaction
-      });
+      }));
 
       const data: BroadcastResponse = response.data;
       
@@ -221,7 +367,7 @@ export class QubicClient {
    */
   async getTransactionStatus(txId: string): Promise<TransactionStatus> {
     try {
-      const response = await this.rpcClient.get(`/v1/transactions/${txId}`);
+      const response = await this.call('getTransactionStatus', () => this.rpcClient.get(`/v1/transactions/${txId}`));
       const data = response.data;
       
       return {
@@ -253,7 +399,7 @@ export class QubicClient {
    */
   async getTransactionsByTick(tick: number): Promise<any[]> {
     try {
-      const response = await this.rpcClient.get(`/v2/ticks/${tick}/transactions`);
+      const response = await this.call('getTransactionsByTick', () => this.rpcClient.get(`/v2/ticks/${tick}/transactions`));
       return response.data.transactions || [];
     } catch (error: any) {
       console.error(`[Qubic Client] Failed to get transactions for tick ${tick}:`, error.message);
@@ -263,60 +409,20 @@ export class QubicClient {
 
   /**
    * Wait for transaction confirmation (REAL)
-   * Polls the network until the transaction is confirmed or timeout occurs
+   * Registers with the client's tick watcher, which polls once for all
+   * in-flight transactions; resolves false if the transaction is not in its
+   * target tick, rejects after maxWaitMs
    */
   async waitForConfirmation(txId: string, targetTick: number, maxWaitMs: number = 60000): Promise<boolean> {
-    const startTime = Date.now();
-    let lastCheckedTick = 0;
-    
     console.log(`[Qubic Client] Waiting for confirmation at tick ${targetTick}...`);
-    
-    while (Date.now() - startTime < maxWaitMs) {
-      try {
-        // Get current tick
-        const currentTick = await this.getCurrentTick();
-        
-        if (currentTick !== lastCheckedTick) {
-          console.log(`[Qubic Client] Current tick: ${currentTick}, Target tick: ${targetTick}`);
-          lastCheckedTick = currentTick;
-        }
-        
-        // Check if we've reached or passed the target tick
-        if (currentTick >= targetTick) {
-          // Try to get transaction status
-          const status = await this.getTransactionStatus(txId);
-          
-          if (status.status === 'confirmed') {
-            console.log(`[Qubic Client] ✓ Transaction confirmed at tick ${status.tick}`);
-            return true;
-          }
-          
-          // Also check transactions in the target tick
-          const transactions = await this.getTransactionsByTick(targetTick);
-          const found = transactions.some((tx: any) => 
-            tx.txId === txId || tx.id === txId
-          );
-          
-          if (found) {
-            console.log(`[Qubic Client] ✓ Transaction found in tick ${targetTick}`);
-            return true;
-          }
-          
-          // If we're more than 10 ticks past target, stop waiting
-          if (currentTick > targetTick + 10) {
-            console.warn(`[Qubic Client] Transaction not found ${currentTick - targetTick} ticks after target`);
-            return false;
-          }
-        }
-      } catch (error: any) {
-        console.error(`[Qubic Client] Error checking confirmation: ${error.message}`);
-      }
-      
-      // Wait 2 seconds before next check
-      await this.sleep(2000);
-    }
-    
-    throw new Error(`Transaction confirmation timeout after ${maxWaitMs}ms`);
+    return this.tickWatcher.waitForConfirmation(txId, targetTick, maxWaitMs);
+  }
+
+  /**
+   * Transactions still waiting for confirmation
+   */
+  pendingConfirmations(): number {
+    return this.tickWatcher.pendingCount();
   }
 
   /**
@@ -324,8 +430,7 @@ export class QubicClient {
    */
   async healthCheck(): Promise<boolean> {
     try {
-      const status = await this.getNetworkStatus();
-      const tick = await this.getCurrentTick();
+      const [status, tick] = await Promise.all([this.getNetworkStatus(), this.getCurrentTick()]);
       
       console.log(`[Qubic Client] ✓ Connected to Qubic RPC`);
       console.log(`[Qubic Client]   Network: ${Config.QUBIC.rpcEndpoint}`);
@@ -343,6 +448,23 @@ export class QubicClient {
     }
   }
 
+  /**
+   * Run one RPC request, counting it and timing it under the client method
+   */
+  private async call(method: string, request: () => Promise<RpcResponse>): Promise<RpcResponse> {
+    const stopTimer = RPC_SECONDS.startTimer({ method });
+    try {
+      const response = await request();
+      RPC_CALLS.inc({ method, outcome: 'ok' });
+      return response;
+    } catch (error: any) {
+      RPC_CALLS.inc({ method, outcome: 'error' });
+      throw error;
+    } finally {
+      stopTimer();
+    }
+  }
+
   /**
    * Extract transaction ID from encoded transaction
    * This is a helper for when the RPC doesn't return a txId
@@ -365,86 +487,10 @@ export class QubicClient {
   }
 
   /**
-   * Parse contract state from raw binary data
-   * This should match your contract's state structure
+   * Batching counters of the RPC transport
    */
-  private parseContractState(rawData: Buffer): EscrowContract {
-    // TODO: Implement proper binary parsing based on your contract's state structure
-    // This is a placeholder that would need to match your actual contract
-    
-    try {
-      // Example structure (adjust based on your actual contract):
-      // struct EscrowState {
-      //   id brandId;           // 32 bytes
-      //   id influencerId;      // 32 bytes
-      //   uint64 escrowBalance; // 8 bytes
-      //   uint8 requiredScore;  // 1 byte
-      //   uint8 verificationScore; // 1 byte
-      //   uint32 retentionEndTick; // 4 bytes
-      //   uint8 isActive;       // 1 byte
-      // };
-      
-      let offset = 0;
-      
-      // Read brandId (32 bytes)
-      const brandId = rawData.slice(offset, offset + 32).toString('hex');
-      offset += 32;
-      
-      // Read influencerId (32 bytes)
-      const influencerId = rawData.slice(offset, offset + 32).toString('hex');
-      offset += 32;
-      
-      // Read escrowBalance (8 bytes, uint64)
-      const escrowBalance = rawData.readBigUInt64LE(offset);
-      offset += 8;
-      
-      // Read requiredScore (1 byte)
-      const requiredScore = rawData.readUInt8(offset);
-      offset += 1;
-      
-      // Read verificationScore (1 byte)
-      const verificationScore = rawData.readUInt8(offset);
-      offset += 1;
-      
-      // Read retentionEndTick (4 bytes)
-      const retentionEndTick = rawData.readUInt32LE(offset);
-      offset += 4;
-      
-      // Read isActive (1 byte)
-      const isActive = rawData.readUInt8(offset) === 1;
-      
-      return {
-        contractId: this.contractId,
-        brandId,
-        influencerId,
-        escrowBalance: Number(escrowBalance),
-        requiredScore,
-        verificationScore,
-        retentionEndTick,
-        isActive
-      };
-    } catch (error) {
-      console.error('[Qubic Client] Failed to parse contract state:', error);
-      
-      // Return default state on error
-      return {
-        contractId: this.contractId,
-        brandId: '',
-        influencerId: '',
-        escrowBalance: 0,
-        requiredScore: 95,
-        verificationScore: 0,
-        retentionEndTick: 0,
-        isActive: false
-      };
-    }
-  }
-
-  /**
-   * Sleep utility
-   */
-  private sleep(ms: number): Promise<void> {
-    return new Promise(resolve => setTimeout(resolve, ms));
+  rpcStats() {
+    return this.rpcClient.stats();
   }
 
   /**
@@ -453,4 +499,26 @@ export class QubicClient {
   getRpcEndpoint(): string {
     return Config.QUBIC.rpcEndpoint;
   }
-}
\ No newline at end of file
+}
+
+/**
+ * Decode a 60-character Qubic identity into its 32-byte public key
+ * Each 14-letter group is a little-endian base-26 uint64; the last 4 letters
+ * are the checksum and are not verified here
+ */
+export function identityToPublicKey(identity: string): Uint8Array {
+  if (!/^[A-Z]{60}$/.test(identity)) {
+    throw new Error('Invalid identity: must be 60 uppercase letters');
+  }
+
+  const publicKey = new Uint8Array(32);
+  const view = new DataView(publicKey.buffer);
+  for (let word = 0; word < 4; word++) {
+    let value = BigInt(0);
+    for (let i = 13; i >= 0; i--) {
+      value = value * BigInt(26) + BigInt(identity.charCodeAt(word * 14 + i) - 65);
+    }
+    view.setBigUint64(word * 8, value, true);
+  }
+  return publicKey;
+}
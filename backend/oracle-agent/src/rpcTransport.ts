@@ -0,0 +1,175 @@
+/**
+ * RPC Transport
+ * Keep-alive connection pool and same-turn request batching for QubicClient
+ */
+import axios, { AxiosInstance } from 'axios';
+import * as http from 'http';
+import * as https from 'https';
+
+export interface RpcTransportOptions {
+  baseURL: string;
+  timeoutMs: number;
+  maxSocketsPerHost: number;  // Concurrent connections to the RPC host
+  batching: boolean;          // Merge requests issued in one event-loop turn into POST /v1/batch
+  maxBatchSize: number;
+}
+
+export interface RpcResponse {
+  status: number;
+  data: any;
+}
+
+interface RpcCall {
+  method: 'GET' | 'POST';
+  path: string;
+  body?: any;
+}
+
+interface PendingCall {
+  call: RpcCall;
+  waiters: Array<{ resolve: (response: RpcResponse) => void; reject: (error: any) => void }>;
+}
+
+/**
+ * Sends RPC calls over pooled keep-alive sockets
+ *
+ * Read calls (get, query) made in the same event-loop turn are queued and
+ * sent as one POST /v1/batch round-trip; identical calls in a batch are sent
+ * once. Failed entries reject like an axios error (error.response.status),
+ * so callers handle batched and direct calls alike. If the RPC has no batch
+ * endpoint (404/405), batching is switched off and calls go out directly.
+ */
+export class RpcTransport {
+  private client: AxiosInstance;
+  private batching: boolean;
+  private queue: Map<string, PendingCall> = new Map();
+  private flushScheduled: boolean = false;
+  private batchesSent: number = 0;
+  private callsBatched: number = 0;
+
+  constructor(private options: RpcTransportOptions) {
+    const agentOptions = { keepAlive: true, maxSockets: options.maxSocketsPerHost };
+    this.client = axios.create({
+      baseURL: options.baseURL,
+      timeout: options.timeoutMs,
+      httpAgent: new http.Agent(agentOptions),
+      httpsAgent: new https.Agent(agentOptions),
+      headers: {
+        'Content-Type': 'application/json',
+        'Accept': 'application/json'
+      }
+    });
+    this.batching = options.batching;
+  }
+
+  /** Batched GET */
+  get(path: string): Promise<RpcResponse> {
+    return this.enqueue({ method: 'GET', path });
+  }
+
+  /** Batched POST, for read-only calls such as querySmartContract */
+  query(path: string, body: any): Promise<RpcResponse> {
+    return this.enqueue({ method: 'POST', path, body });
+  }
+
+  /** Unbatched POST, for calls with side effects such as broadcasts */
+  async post(path: string, body: any): Promise<RpcResponse> {
+    const response = await this.client.post(path, body);
+    return { status: response.status, data: response.data };
+  }
+
+  stats() {
+    return {
+      batching: this.batching,
+      batchesSent: this.batchesSent,
+      callsBatched: this.callsBatched
+    };
+  }
+
+  private enqueue(call: RpcCall): Promise<RpcResponse> {
+    return new Promise((resolve, reject) => {
+      const key = `${call.method} ${call.path} ${call.body === undefined ? '' : JSON.stringify(call.body)}`;
+      let pending = this.queue.get(key);
+      if (!pending) {
+        pending = { call, waiters: [] };
+        this.queue.set(key, pending);
+      }
+      pending.waiters.push({ resolve, reject });
+
+      if (!this.flushScheduled) {
+        this.flushScheduled = true;
+        setImmediate(() => this.flush());
+      }
+    });
+  }
+
+  private flush(): void {
+    const pending = Array.from(this.queue.values());
+    this.queue.clear();
+    this.flushScheduled = false;
+
+    for (let i = 0; i < pending.length; i += this.options.maxBatchSize) {
+      const chunk = pending.slice(i, i + this.options.maxBatchSize);
+      if (this.batching && chunk.length > 1) {
+        this.sendBatch(chunk);
+      } else {
+        chunk.forEach(entry => this.sendDirect(entry));
+      }
+    }
+  }
+
+  private async sendDirect(entry: PendingCall): Promise<void> {
+    try {
+      const { method, path, body } = entry.call;
+      const response = method === 'GET' ? await this.client.get(path) : await this.client.post(path, body);
+      settle(entry, { status: response.status, data: response.data });
+    } catch (error: any) {
+      entry.waiters.forEach(waiter => waiter.reject(error));
+    }
+  }
+
+  private async sendBatch(entries: PendingCall[]): Promise<void> {
+    let responses: RpcResponse[];
+    try {
+      const response = await this.client.post('/v1/batch', {
+        requests: entries.map(entry => entry.call)
+      });
+      responses = response.data?.responses;
+      if (!Array.isArray(responses) || responses.length !== entries.length) {
+        throw new Error('Invalid batch response from RPC');
+      }
+    } catch (error: any) {
+      const status = error.response?.status;
+      if (status === 404 || status === 405) {
+        console.warn('[RPC Transport] RPC has no batch endpoint, sending requests individually');
+        this.batching = false;
+        entries.forEach(entry => this.sendDirect(entry));
+        return;
+      }
+      entries.forEach(entry => entry.waiters.forEach(waiter => waiter.reject(error)));
+      return;
+    }
+
+    this.batchesSent++;
+    this.callsBatched += entries.length;
+    entries.forEach((entry, i) => settle(entry, responses[i]));
+  }
+}
+
+/**
+ * Resolve a call's waiters with its response, or reject them with an
+ * axios-shaped error if the status is not 2xx
+ */
+function settle(entry: PendingCall, response: RpcResponse): void {
+  if (response.status >= 200 && response.status < 300) {
+    entry.waiters.forEach(waiter => waiter.resolve(response));
+    return;
+  }
+
+  const message = response.data?.error || `Request failed with status code ${response.status}`;
+  entry.waiters.forEach(waiter => {
+    const error: any = new Error(message);
+    error.response = response;
+    waiter.reject(error);
+  });
+}
@@ -0,0 +1,297 @@
+/**
+ * State Store
+ * Crash-safe OracleState: append-only write-ahead log plus periodic snapshots
+ *
+ * Every change to the agent's state is appended to oracle-state.wal as one
+ * JSON line and applied to the in-memory state in the same call. Every
+ * snapshotEvery records the whole state is written to oracle-state.snapshot.json
+ * (temp file, fsync, rename) and the log is truncated. load() reads the
+ * snapshot and replays the records after it; each record carries a sequence
+ * number, so records already in the snapshot are skipped, and a torn last
+ * line from a crash mid-write is dropped.
+ *
+ * Records are written with writeSync, so they survive the process being
+ * killed. The two records that guard against a double submission
+ * (submitting, before a broadcast, and broadcast, after it) are also fsynced.
+ */
+import * as fs from 'fs';
+import * as path from 'path';
+import { OracleState, PersistedJob, VerificationRequest, VerificationResult } from './types';
+import { PipelineJournal, SubmittedTransaction } from './verificationPipeline';
+
+const SNAPSHOT_FILE = 'oracle-state.snapshot.json';
+const WAL_FILE = 'oracle-state.wal';
+const SNAPSHOT_VERSION = 2;
+// Version 1 kept pending slots without deposit ticks; they are re-read from the contract
+const SNAPSHOT_VERSION_SLOTS_ONLY = 1;
+
+type WalRecord =
+  | { n: number; type: 'tick'; tick: number }
+  | { n: number; type: 'escrows'; sequence: string; escrows?: Array<[number, number]> } // escrows missing in old logs
+  | { n: number; type: 'completed'; postUrl: string; result: VerificationResult }
+  | { n: number; type: 'accepted'; id: string; request: VerificationRequest }
+  | { n: number; type: 'scored'; id: string; aiResult: VerificationResult }
+  | { n: number; type: 'submitting'; ids: string[]; transaction: SubmittedTransaction }
+  | { n: number; type: 'broadcast'; ids: string[]; txId: string }
+  | { n: number; type: 'finished'; ids: string[] };
+
+// A record before append() numbers it (Omit distributed over the union)
+type Unsequenced<T> = T extends any ? Omit<T, 'n'> : never;
+type NewRecord = Unsequenced<WalRecord>;
+
+interface Snapshot {
+  version: number;
+  sequence: number; // Last record included
+  lastProcessedTick: number;
+  lastEventSequence: string;
+  pendingEscrows?: Array<[number, number]>; // Missing in version 1
+  completedVerifications: Array<[string, VerificationResult]>;
+  jobs: PersistedJob[];
+}
+
+export interface RecoveredState {
+  state: OracleState;
+  jobs: PersistedJob[];   // Pipeline jobs that had not finished
+  records: number;        // Log records replayed on top of the snapshot
+}
+
+export class StateStore implements PipelineJournal {
+  private state: OracleState = {
+    lastProcessedTick: 0,
+    completedVerifications: new Map(),
+    pendingEscrows: new Map(),
+    lastEventSequence: BigInt(0)
+  };
+  private jobs: Map<string, PersistedJob> = new Map();
+  private sequence: number = 0;
+  private recordsSinceSnapshot: number = 0;
+  private walFd: number | null = null;
+  private snapshotPath: string;
+  private walPath: string;
+
+  constructor(private dir: string, private snapshotEvery: number) {
+    this.snapshotPath = path.join(dir, SNAPSHOT_FILE);
+    this.walPath = path.join(dir, WAL_FILE);
+  }
+
+  /**
+   * Read the snapshot and replay the log; the returned state is live and is
+   * updated by the record methods
+   */
+  load(): RecoveredState {
+    fs.mkdirSync(this.dir, { recursive: true });
+
+    if (fs.existsSync(this.snapshotPath)) {
+      this.restoreSnapshot(JSON.parse(fs.readFileSync(this.snapshotPath, 'utf8')));
+    }
+
+    let replayed = 0;
+    if (fs.existsSync(this.walPath)) {
+      const lines = fs.readFileSync(this.walPath, 'utf8').split('\n');
+      for (let i = 0; i < lines.length; i++) {
+        if (!lines[i]) {
+          continue;
+        }
+        let record: WalRecord;
+        try {
+          record = JSON.parse(lines[i]);
+        } catch (error) {
+          // Only a last line without its newline can be torn; anything else is corruption
+          if (i !== lines.length - 1) {
+            throw new Error(`Corrupt state log ${this.walPath} at line ${i + 1}`);
+          }
+          console.warn(`[State Store] Dropping torn record at end of ${this.walPath}`);
+          break;
+        }
+        if (record.n <= this.sequence) {
+          continue;
+        }
+        this.apply(record);
+        this.sequence = record.n;
+        replayed++;
+      }
+    }
+
+    // Start from a fresh snapshot so the log holds only this run's records
+    this.snapshot();
+
+    return { state: this.state, jobs: Array.from(this.jobs.values()), records: replayed };
+  }
+
+  // ------------------------------------------------------------------
+  // Agent state
+  // ------------------------------------------------------------------
+
+  recordTick(tick: number): void {
+    this.append({ type: 'tick', tick });
+  }
+
+  recordEscrows(sequence: bigint, escrows: Map<number, number>): void {
+    this.append({ type: 'escrows', sequence: sequence.toString(), escrows: Array.from(escrows) });
+  }
+
+  recordCompleted(postUrl: string, result: VerificationResult): void {
+    this.append({ type: 'completed', postUrl, result });
+  }
+
+  // ------------------------------------------------------------------
+  // Pipeline journal
+  // ------------------------------------------------------------------
+
+  accepted(id: string, request: VerificationRequest): void {
+    this.append({ type: 'accepted', id, request });
+  }
+
+  scored(id: string, aiResult: VerificationResult): void {
+    this.append({ type: 'scored', id, aiResult });
+  }
+
+  submitting(ids: string[], transaction: SubmittedTransaction): void {
+    this.append({ type: 'submitting', ids, transaction }, true);
+  }
+
+  broadcast(ids: string[], txId: string): void {
+    this.append({ type: 'broadcast', ids, txId }, true);
+  }
+
+  finished(ids: string[]): void {
+    this.append({ type: 'finished', ids });
+  }
+
+  /**
+   * Snapshot and close the log (on shutdown)
+   */
+  close(): void {
+    this.snapshot();
+    if (this.walFd !== null) {
+      fs.closeSync(this.walFd);
+      this.walFd = null;
+    }
+  }
+
+  /**
+   * Write the whole state and truncate the log
+   */
+  snapshot(): void {
+    const snapshot: Snapshot = {
+      version: SNAPSHOT_VERSION,
+      sequence: this.sequence,
+      lastProcessedTick: this.state.lastProcessedTick,
+      lastEventSequence: this.state.lastEventSequence.toString(),
+      pendingEscrows: Array.from(this.state.pendingEscrows),
+      completedVerifications: Array.from(this.state.completedVerifications),
+      jobs: Array.from(this.jobs.values())
+    };
+
+    const tempPath = `${this.snapshotPath}.tmp`;
+    const fd = fs.openSync(tempPath, 'w');
+    try {
+      fs.writeSync(fd, JSON.stringify(snapshot));
+      fs.fsyncSync(fd);
+    } finally {
+      fs.closeSync(fd);
+    }
+    fs.renameSync(tempPath, this.snapshotPath);
+
+    // Records up to snapshot.sequence are skipped on replay, so a crash
+    // before this truncation only leaves redundant records behind
+    if (this.walFd === null) {
+      this.walFd = fs.openSync(this.walPath, 'a');
+    }
+    fs.ftruncateSync(this.walFd, 0);
+    this.recordsSinceSnapshot = 0;
+  }
+
+  private append(record: NewRecord, durable: boolean = false): void {
+    const full = { ...record, n: this.sequence + 1 } as WalRecord;
+    this.apply(full);
+    this.sequence = full.n;
+
+    if (this.walFd === null) {
+      this.walFd = fs.openSync(this.walPath, 'a');
+    }
+    fs.writeSync(this.walFd, JSON.stringify(full) + '\n');
+    if (durable) {
+      fs.fdatasyncSync(this.walFd);
+    }
+
+    if (++this.recordsSinceSnapshot >= this.snapshotEvery) {
+      this.snapshot();
+    }
+  }
+
+  private apply(record: WalRecord): void {
+    const state = this.state;
+    switch (record.type) {
+      case 'tick':
+        state.lastProcessedTick = Math.max(state.lastProcessedTick, record.tick);
+        break;
+      case 'escrows':
+        this.restoreEscrows(record.sequence, record.escrows);
+        break;
+      case 'completed':
+        state.completedVerifications.set(record.postUrl, record.result);
+        break;
+      case 'accepted':
+        this.jobs.set(record.id, { id: record.id, request: record.request, stage: 'accepted' });
+        break;
+      case 'scored': {
+        const job = this.jobs.get(record.id);
+        if (job) {
+          job.stage = 'scored';
+          job.aiResult = record.aiResult;
+        }
+        break;
+      }
+      case 'submitting':
+        for (const id of record.ids) {
+          const job = this.jobs.get(id);
+          if (job) {
+            job.stage = 'submitting';
+            job.transaction = { ...record.transaction };
+          }
+        }
+        break;
+      case 'broadcast':
+        for (const id of record.ids) {
+          const job = this.jobs.get(id);
+          if (job?.transaction) {
+            job.stage = 'broadcast';
+            job.transaction.txId = record.txId;
+          }
+        }
+        break;
+      case 'finished':
+        for (const id of record.ids) {
+          this.jobs.delete(id);
+        }
+        break;
+    }
+  }
+
+  private restoreSnapshot(snapshot: Snapshot): void {
+    if (snapshot.version !== SNAPSHOT_VERSION && snapshot.version !== SNAPSHOT_VERSION_SLOTS_ONLY) {
+      throw new Error(`Unsupported state snapshot version ${snapshot.version} in ${this.snapshotPath}`);
+    }
+    this.sequence = snapshot.sequence;
+    this.state.lastProcessedTick = snapshot.lastProcessedTick;
+    this.restoreEscrows(snapshot.lastEventSequence, snapshot.pendingEscrows);
+    this.state.completedVerifications = new Map(snapshot.completedVerifications);
+    this.jobs = new Map(snapshot.jobs.map(job => [job.id, job]));
+  }
+
+  /**
+   * Pending escrows written without their deposit ticks (by an older
+   * version) are dropped and the event sequence reset, so the next
+   * monitoring cycle re-reads them from the contract
+   */
+  private restoreEscrows(sequence: string, escrows?: Array<[number, number]>): void {
+    if (!escrows) {
+      this.state.lastEventSequence = BigInt(0);
+      this.state.pendingEscrows = new Map();
+      return;
+    }
+    this.state.lastEventSequence = BigInt(sequence);
+    this.state.pendingEscrows = new Map(escrows);
+  }
+}
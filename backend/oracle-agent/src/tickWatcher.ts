@@ -0,0 +1,211 @@
+/**
+ * Tick Watcher
+ * One polling loop per agent that confirms every in-flight transaction
+ *
+ * Waits are grouped by target tick. A transaction is looked for in every
+ * tick from its target to CONFIRMATION_TICK_WINDOW ticks later: each poll
+ * reads the current tick once, fetches the transaction list of every tick
+ * some wait's window has reached once, and resolves all waits it finds from
+ * a txId map. A list that came back non-empty is final and is not fetched
+ * again. Waits still unresolved once the current tick is past their whole
+ * window are failed together; a missing txId in one tick proves nothing
+ * before that, since the archive may lag or the transaction may land later.
+ */
+
+// Ticks past the target after which a missing transaction counts as failed
+export const CONFIRMATION_TICK_WINDOW = 10;
+
+/** The RPC calls the watcher needs (implemented by QubicClient) */
+export interface TickSource {
+  getCurrentTick(): Promise<number>;
+  getTransactionsByTick(tick: number): Promise<any[]>;
+}
+
+interface PendingConfirmation {
+  txId: string;
+  targetTick: number;
+  deadline: number; // Date.now() after which the wait rejects
+  resolve: (confirmed: boolean) => void;
+  reject: (error: Error) => void;
+}
+
+export class TickWatcher {
+  private waits: Map<string, PendingConfirmation> = new Map();
+  private waitsByTick: Map<number, Set<string>> = new Map();
+  private tickTxIds: Map<number, Set<string>> = new Map(); // Ticks whose non-empty list was fetched
+  private running: boolean = false;
+  private lastTick: number = 0;
+
+  constructor(
+    private source: TickSource,
+    private pollIntervalMs: number
+  ) {}
+
+  /**
+   * Resolve true once txId appears in a tick from targetTick to
+   * targetTick + CONFIRMATION_TICK_WINDOW, false if the current tick has
+   * passed that window without it; reject after maxWaitMs
+   */
+  waitForConfirmation(txId: string, targetTick: number, maxWaitMs: number): Promise<boolean> {
+    return new Promise<boolean>((resolve, reject) => {
+      const existing = this.waits.get(txId);
+      if (existing) {
+        // Same transaction waited on twice: settle both from one entry
+        const previousResolve = existing.resolve;
+        const previousReject = existing.reject;
+        existing.resolve = confirmed => { previousResolve(confirmed); resolve(confirmed); };
+        existing.reject = error => { previousReject(error); reject(error); };
+        return;
+      }
+
+      this.waits.set(txId, { txId, targetTick, deadline: Date.now() + maxWaitMs, resolve, reject });
+      let ids = this.waitsByTick.get(targetTick);
+      if (!ids) {
+        ids = new Set();
+        this.waitsByTick.set(targetTick, ids);
+      }
+      ids.add(txId);
+
+      if (!this.running) {
+        this.running = true;
+        this.run();
+      }
+    });
+  }
+
+  /** Confirmations currently being waited for */
+  pendingCount(): number {
+    return this.waits.size;
+  }
+
+  /**
+   * Poll until no waits are left (no idle polling)
+   */
+  private async run(): Promise<void> {
+    while (this.waits.size > 0) {
+      try {
+        await this.poll();
+      } catch (error: any) {
+        console.error(`[Tick Watcher] Error checking confirmations: ${error.message}`);
+      }
+
+      this.expireDeadlines();
+      if (this.waits.size > 0) {
+        await this.sleep(this.pollIntervalMs);
+      }
+    }
+    this.running = false;
+  }
+
+  /**
+   * One round: current tick once, then each tick inside a wait's window once
+   */
+  private async poll(): Promise<void> {
+    const currentTick = await this.source.getCurrentTick();
+    if (currentTick !== this.lastTick) {
+      console.log(`[Tick Watcher] Tick ${currentTick}: ${this.waits.size} confirmation(s) pending`);
+      this.lastTick = currentTick;
+    }
+
+    const targetTicks = Array.from(this.waitsByTick.keys()).filter(tick => tick <= currentTick);
+    const scanTicks = new Set<number>();
+    for (const target of targetTicks) {
+      const last = Math.min(currentTick, target + CONFIRMATION_TICK_WINDOW);
+      for (let tick = target; tick <= last; tick++) {
+        if (!this.tickTxIds.has(tick)) {
+          scanTicks.add(tick);
+        }
+      }
+    }
+
+    const ticks = Array.from(scanTicks);
+    const tickTransactions = await Promise.all(ticks.map(tick => this.source.getTransactionsByTick(tick)));
+    ticks.forEach((tick, i) => {
+      // An empty list may just mean the archive has not caught up yet
+      if (tickTransactions[i].length > 0) {
+        const txIds = new Set<string>();
+        for (const tx of tickTransactions[i]) {
+          const txId = tx?.txId ?? tx?.id ?? tx?.transaction?.txId;
+          if (txId !== undefined) {
+            txIds.add(txId);
+          }
+        }
+        this.tickTxIds.set(tick, txIds);
+      }
+    });
+
+    for (const target of targetTicks) {
+      const last = Math.min(currentTick, target + CONFIRMATION_TICK_WINDOW);
+      for (const txId of Array.from(this.waitsByTick.get(target) as Set<string>)) {
+        for (let tick = target; tick <= last; tick++) {
+          if (this.tickTxIds.get(tick)?.has(txId)) {
+            console.log(`[Tick Watcher] ✓ Transaction ${txId} found in tick ${tick}`);
+            this.settle(txId, true);
+            break;
+          }
+        }
+      }
+
+      if (currentTick > target + CONFIRMATION_TICK_WINDOW && this.waitsByTick.has(target)) {
+        const missing = Array.from(this.waitsByTick.get(target) as Set<string>);
+        console.warn(`[Tick Watcher] ${missing.length} transaction(s) not found in ticks ${target}-${last} (now ${currentTick})`);
+        for (const txId of missing) {
+          this.settle(txId, false);
+        }
+      }
+    }
+
+    this.pruneTickTxIds();
+  }
+
+  /**
+   * Forget fetched ticks that no remaining wait's window covers
+   */
+  private pruneTickTxIds(): void {
+    let lowest = Infinity;
+    for (const target of this.waitsByTick.keys()) {
+      lowest = Math.min(lowest, target);
+    }
+    for (const tick of Array.from(this.tickTxIds.keys())) {
+      if (tick < lowest) {
+        this.tickTxIds.delete(tick);
+      }
+    }
+  }
+
+  /**
+   * Reject every wait past its wall-clock deadline
+   */
+  private expireDeadlines(): void {
+    const now = Date.now();
+    for (const wait of Array.from(this.waits.values())) {
+      if (now >= wait.deadline) {
+        this.remove(wait);
+        wait.reject(new Error(`Transaction confirmation timeout for ${wait.txId}`));
+      }
+    }
+  }
+
+  private settle(txId: string, confirmed: boolean): void {
+    const wait = this.waits.get(txId);
+    if (wait) {
+      this.remove(wait);
+      wait.resolve(confirmed);
+    }
+  }
+
+  private remove(wait: PendingConfirmation): void {
+    this.waits.delete(wait.txId);
+    const ids = this.waitsByTick.get(wait.targetTick);
+    if (ids) {
+      ids.delete(wait.txId);
+      if (ids.size === 0) {
+        this.waitsByTick.delete(wait.targetTick);
+      }
+    }
+  }
+
+  private sleep(ms: number): Promise<void> {
+    return new Promise(resolve => setTimeout(resolve, ms));
+  }
+}
@@ -3,7 +3,19 @@
  * Uses QubicPackageBuilder correctly with Uint8Array
  */
 import { Config } from './config';
-import { ContractProcedure } from './types';
+import { ContractProcedure, CosignedScore, ScoreSubmission } from './types';
+import {
+  COSIGNED_SCORES_HEADER_SIZE,
+  CosignedScoreEntryView,
+  CosignedScoreMessageView,
+  EscrowKeyView,
+  MAX_COSIGNED_SCORES,
+  MAX_SCORE_BATCH,
+  SCORE_BATCH_HEADER_SIZE,
+  ScoreBatchEntryView,
+  ScoreInputView
+} from './escrowWire';
+import { QubicClient } from './qubicClient';
 
 // Import using default export (the library exports everything this way)
 import QubicLib from '@qubic-lib/qubic-ts-library';
@@ -36,28 +48,116 @@ export class TransactionBuilder {
   }
 
   /**
-   * Build and sign transaction to set verification score
+   * Build and sign transaction to set one escrow's verification score
+   * The escrow is addressed by its key (see QubicClient.escrowKey)
    * Returns a properly encoded transaction ready for broadcast
    */
   async buildSetVerificationScoreTransaction(
     contractId: string,
+    key: EscrowKeyView,
     score: number,
     currentTick: number
   ): Promise<BuildTransactionResult> {
-    console.log(`[TX Builder] Building setVerificationScore transaction: score=${score}`);
+    console.log(`[TX Builder] Building setVerificationScore transaction: nonce=${key.campaignNonce} score=${score}`);
 
     // Calculate target tick (give enough time for broadcast and processing)
     const targetTick = currentTick + 30; // 30 ticks ahead for safety
 
-    // Create payload with score
-    const payload = this.createScorePayload(score);
+    // Create payload with escrow key and score
+    const payload = this.createScorePayload(key, score);
 
+    return this.buildContractTransaction(
+      contractId,
+      ContractProcedure.SET_VERIFICATION_SCORE,
+      payload,
+      targetTick
+    );
+  }
+
+  /**
+   * Build and sign one transaction carrying many verification scores
+   * The contract checks the oracle once and applies every entry in a single pass
+   */
+  async buildSetVerificationScoreBatchTransaction(
+    contractId: string,
+    submissions: ScoreSubmission[],
+    currentTick: number
+  ): Promise<BuildTransactionResult> {
+    console.log(`[TX Builder] Building setVerificationScoreBatch transaction: ${submissions.length} scores`);
+
+    if (submissions.length === 0 || submissions.length > MAX_SCORE_BATCH) {
+      throw new Error(`Score batch must contain 1-${MAX_SCORE_BATCH} entries, got ${submissions.length}`);
+    }
+
+    const targetTick = currentTick + 30; // 30 ticks ahead for safety
+    const payload = this.createScoreBatchPayload(submissions);
+
+    return this.buildContractTransaction(
+      contractId,
+      ContractProcedure.SET_VERIFICATION_SCORE_BATCH,
+      payload,
+      targetTick
+    );
+  }
+
+  /**
+   * Build one relay transaction carrying scores co-signed by several oracles
+   * Each entry is checked against its own oracle's signature, so any oracle
+   * (or relay) can post the whole set's scores instead of one call per oracle
+   */
+  async buildSubmitCosignedScoresTransaction(
+    contractId: string,
+    scores: CosignedScore[],
+    currentTick: number
+  ): Promise<BuildTransactionResult> {
+    console.log(`[TX Builder] Building submitCosignedScores transaction: ${scores.length} scores`);
+
+    if (scores.length === 0 || scores.length > MAX_COSIGNED_SCORES) {
+      throw new Error(`Co-signed batch must contain 1-${MAX_COSIGNED_SCORES} entries, got ${scores.length}`);
+    }
+
+    const targetTick = currentTick + 30; // 30 ticks ahead for safety
+    const payload = this.createCosignedScoresPayload(scores);
+
+    return this.buildContractTransaction(
+      contractId,
+      ContractProcedure.SUBMIT_COSIGNED_SCORES,
+      payload,
+      targetTick
+    );
+  }
+
+  /**
+   * Message an oracle signs for submitCosignedScores
+   * Sign the K12 digest of these bytes; the contract rebuilds them from the
+   * escrow in the slot, so a signature cannot be reused on another escrow.
+   * depositTick is the escrow's StateResponse.depositTick, which tells
+   * apart successive escrows with the same key in a reused slot.
+   */
+  static createCosignedScoreMessage(key: EscrowKeyView, slot: number, depositTick: number, score: number): Uint8Array {
+    const message = CosignedScoreMessageView.alloc();
+    message.bytes.set(key.bytes.subarray(0, EscrowKeyView.SIZE), 0);
+    message.slot = slot;
+    message.depositTick = depositTick;
+    message.score = Math.max(0, Math.min(100, Math.round(score)));
+    return message.bytes;
+  }
+
+  /**
+   * Sign and encode a zero-amount contract call
+   */
+  private async buildContractTransaction(
+    contractId: string,
+    inputType: ContractProcedure,
+    payload: any,
+    targetTick: number
+  ): Promise<BuildTransactionResult> {
     // Build the transaction using Qubic library
     const transaction = new QubicTransaction()
       .setSourcePublicKey(new PublicKey(this.oraclePublicKey))
       .setDestinationPublicKey(new PublicKey(contractId))
       .setTick(targetTick)
-      .setInputType(ContractProcedure.SET_VERIFICATION_SCORE)
+      .setInputType(inputType)
       .setInputSize(payload.getPackageSize())
       .setAmount(new Long(BigInt(0))) // No funds transfer
       .setPayload(payload);
@@ -72,7 +172,7 @@ export class TransactionBuilder {
     );
 
     // Generate transaction ID
-    const transactionId = this.generateTransactionId(targetTick);
+    const transactionId = this.generateTransactionId(targetTick, inputType);
 
     console.log(`[TX Builder] ✓ Transaction signed and encoded`);
     console.log(`[TX Builder]   Target tick: ${targetTick}`);
@@ -83,33 +183,80 @@ export class TransactionBuilder {
       encodedTransaction,
       transactionId,
       targetTick,
-      inputType: ContractProcedure.SET_VERIFICATION_SCORE
+      inputType
     };
   }
 
   /**
    * Create payload for score submission
-   * Payload structure: 1 byte containing score (0-100)
+   * Payload structure: ScoreInput, escrow key then score (see escrowWire.ts)
    * 
    * IMPORTANT: QubicPackageBuilder.add() expects Uint8Array directly
    */
-  private createScorePayload(score: number): any {
-    // Ensure score is integer 0-100
-    const normalizedScore = Math.max(0, Math.min(100, Math.round(score)));
-
-    // Create 1-byte buffer for uint8 score
-    const buffer = new ArrayBuffer(1);
-    const view = new DataView(buffer);
-    view.setUint8(0, normalizedScore);
-    
-    // Convert to Uint8Array
-    const scoreData = new Uint8Array(buffer);
+  private createScorePayload(key: EscrowKeyView, score: number): any {
+    const input = ScoreInputView.alloc();
+    input.bytes.set(key.bytes.subarray(0, EscrowKeyView.SIZE), 0);
+    input.score = Math.max(0, Math.min(100, Math.round(score)));
 
     // Create dynamic payload directly (skip QubicPackageBuilder if causing issues)
-    const payload = new DynamicPayload(scoreData.length);
-    payload.setPayload(scoreData);
+    const payload = new DynamicPayload(ScoreInputView.SIZE);
+    payload.setPayload(input.bytes);
+
+    console.log(`[TX Builder] Payload created: ${input.score} (${ScoreInputView.SIZE} bytes)`);
+
+    return payload;
+  }
+
+  /**
+   * Create payload for batched score submission
+   * Payload structure: uint32 count, then count x ScoreBatchEntry (see escrowWire.ts)
+   */
+  private createScoreBatchPayload(submissions: ScoreSubmission[]): any {
+    const totalSize = SCORE_BATCH_HEADER_SIZE + submissions.length * ScoreBatchEntryView.SIZE;
+    const buffer = new Uint8Array(totalSize);
+
+    new DataView(buffer.buffer).setUint32(0, submissions.length, true);
+    submissions.forEach((submission, i) => {
+      const offset = SCORE_BATCH_HEADER_SIZE + i * ScoreBatchEntryView.SIZE;
+      const entry = new ScoreBatchEntryView(buffer.subarray(offset, offset + ScoreBatchEntryView.SIZE));
+      entry.slot = submission.slot;
+      entry.depositTick = submission.depositTick;
+      entry.score = Math.max(0, Math.min(100, Math.round(submission.score)));
+    });
+
+    const payload = new DynamicPayload(totalSize);
+    payload.setPayload(buffer);
+
+    console.log(`[TX Builder] Batch payload created: ${submissions.length} scores (${totalSize} bytes)`);
+
+    return payload;
+  }
+
+  /**
+   * Create payload for a co-signed score relay
+   * Payload structure: uint32 count, then count x CosignedScoreEntry (see escrowWire.ts)
+   */
+  private createCosignedScoresPayload(scores: CosignedScore[]): any {
+    const totalSize = COSIGNED_SCORES_HEADER_SIZE + scores.length * CosignedScoreEntryView.SIZE;
+    const buffer = new Uint8Array(totalSize);
+
+    new DataView(buffer.buffer).setUint32(0, scores.length, true);
+    scores.forEach((score, i) => {
+      if (score.signature.length !== 64) {
+        throw new Error(`Co-signed score ${i} has a ${score.signature.length}-byte signature, expected 64`);
+      }
+      const offset = COSIGNED_SCORES_HEADER_SIZE + i * CosignedScoreEntryView.SIZE;
+      const entry = new CosignedScoreEntryView(buffer.subarray(offset, offset + CosignedScoreEntryView.SIZE));
+      entry.slot = score.slot;
+      entry.score = Math.max(0, Math.min(100, Math.round(score.score)));
+      entry.oracleIndex = score.oracleIndex;
+      entry.signature = score.signature;
+    });
+
+    const payload = new DynamicPayload(totalSize);
+    payload.setPayload(buffer);
 
-    console.log(`[TX Builder] Payload created: ${normalizedScore} (${scoreData.length} byte)`);
+    console.log(`[TX Builder] Co-signed payload created: ${scores.length} scores (${totalSize} bytes)`);
 
     return payload;
   }
@@ -160,14 +307,14 @@ export class TransactionBuilder {
    * Generate deterministic transaction ID
    * Based on source, destination, tick, and input type
    */
-  private generateTransactionId(targetTick: number): string {
+  private generateTransactionId(targetTick: number, inputType: ContractProcedure): string {
     const crypto = require('crypto');
     
     const idString = [
       this.oraclePublicKey,
       Config.QUBIC.contractId,
       targetTick.toString(),
-      ContractProcedure.SET_VERIFICATION_SCORE.toString(),
+      inputType.toString(),
       Date.now().toString()
     ].join(':');
     
@@ -252,9 +399,12 @@ export class TransactionBuilder {
       // Create a test transaction
       const testTick = 12345678;
       const testScore = 87;
+      // Any well-formed key will do; the oracle's own identity stands in for both parties
+      const testKey = QubicClient.escrowKey(this.oraclePublicKey, this.oraclePublicKey, BigInt(1));
       
       const result = await this.buildSetVerificationScoreTransaction(
         Config.QUBIC.contractId,
+        testKey,
         testScore,
         testTick
       );
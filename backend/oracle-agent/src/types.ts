@@ -8,6 +8,10 @@ export interface QubicConfig {
   oraclePrivateKey: string;
   oraclePublicKey: string;
   networkId: number;
+  contractIndex: number; // Escrow contract index for queries (0 = not configured)
+  rpcMaxSockets: number;   // Keep-alive connections to the RPC host
+  rpcBatching: boolean;    // Send same-turn reads as one /v1/batch request
+  rpcMaxBatchSize: number;
 }
 
 export interface AIServiceConfig {
@@ -18,6 +22,20 @@ export interface AIServiceConfig {
 export interface VerificationRequest {
   postUrl: string;
   scenario?: 'legitimate' | 'bot_fraud' | 'mixed_quality';
+  escrowSlot?: number; // Contract slot the score is for (from depositFunds); required by the pipeline
+  escrowDepositTick?: number; // Deposit tick of the escrow in that slot, set from the synced pending set
+}
+
+export interface ScoreSubmission {
+  slot: number;
+  depositTick: number;   // Escrow's deposit tick; the contract skips the entry if the slot was reused
+  score: number;
+}
+
+/** One oracle's signed score, relayed with others in submitCosignedScores */
+export interface CosignedScore extends ScoreSubmission {
+  oracleIndex: number;   // Signer's position in the contract's oracle set
+  signature: Uint8Array; // 64-byte signature over the K12 digest of the CosignedScoreMessage
 }
 
 export interface VerificationResult {
@@ -45,17 +63,6 @@ export interface ScoreDetail {
   details: any;
 }
 
-export interface EscrowContract {
-  contractId: string;
-  brandId: string;
-  influencerId: string;
-  escrowBalance: number;
-  requiredScore: number;
-  verificationScore: number;
-  retentionEndTick: number;
-  isActive: boolean;
-}
-
 export interface Transaction {
   sourceId: string;
   destId: string;
@@ -75,18 +82,28 @@ export interface TransactionStatus {
 
 export interface OracleState {
   lastProcessedTick: number;
-  pendingVerifications: Map<string, VerificationRequest>;
   completedVerifications: Map<string, VerificationResult>;
+  pendingEscrows: Map<number, number>; // Slot -> deposit tick of each escrow awaiting a score, from the last monitoring cycle
+  lastEventSequence: bigint; // Last contract event applied to pendingEscrows (0 = never synced)
 }
 
-export enum ContractProcedure {
-  DEPOSIT_FUNDS = 0,
-  SET_VERIFICATION_SCORE = 1,
-  RELEASE_PAYMENT = 2,
-  REFUND_FUNDS = 3,
-  SET_ORACLE_ID = 4
+/** A pipeline job as recorded in the state log, for resuming after a restart */
+export interface PersistedJob {
+  id: string;
+  request: VerificationRequest;
+  stage: 'accepted' | 'scored' | 'submitting' | 'broadcast';
+  aiResult?: VerificationResult;
+  transaction?: {
+    encodedTransaction: string; // Signed bytes, re-sent unchanged if the broadcast was interrupted
+    targetTick: number;
+    inputType: number;
+    txId?: string;              // Set once broadcast
+  };
 }
 
+// Procedure numbers are generated from contracts/src/escrow_wire.h
+export { EscrowProcedure as ContractProcedure } from './escrowWire';
+
 export interface OracleLog {
   timestamp: Date;
   level: 'info' | 'warn' | 'error';
@@ -0,0 +1,494 @@
+/**
+ * Verification Pipeline
+ * Staged, bounded-concurrency processing of verification requests
+ *
+ *   submit() -> [scoring queue] -> AI pool -> [submission queue] -> chain pool -> confirmation
+ *
+ * The AI pool and the chain pool have separate concurrency limits, so new AI
+ * calls run while earlier transactions are being broadcast and confirmed.
+ * An AI worker takes up to aiBatchSize queued requests and scores them in one
+ * /verify/batch call.
+ * A chain worker takes every scored request with an escrow slot waiting in
+ * the submission queue (up to batchSize) and sends them as one
+ * setVerificationScoreBatch transaction; scores pile up while the workers
+ * are busy, so batches grow with load without a linger timer. A worker is
+ * released once its transaction is broadcast, and confirmation continues on
+ * the shared tick watcher.
+ *
+ * Requests count against maxQueueDepth from submit() until their result is
+ * known; submit() rejects with QueueFullError beyond that, and with
+ * InvalidRequestError for a request whose escrow slot is not awaiting a
+ * score. An accepted request is bound to the escrow's deposit tick, which
+ * goes into its batch entry, so the contract skips the score if the slot
+ * has been reused by the time the transaction lands.
+ *
+ * With a journal, each job's progress (accepted, scored, submitting,
+ * broadcast, finished) is recorded as it happens, so resume() can continue
+ * unfinished jobs after a restart without scoring or submitting them twice.
+ */
+import { randomUUID } from 'crypto';
+import { AIClient } from './aiClient';
+import { QubicClient } from './qubicClient';
+import { TransactionBuilder } from './transactionBuilder';
+import { PersistedJob, VerificationRequest, VerificationResult } from './types';
+import { MAX_SCORE_BATCH } from './escrowWire';
+import { registry } from './metrics';
+
+// stage: queued (waiting for an AI worker), scoring (one AI call),
+// submission (build and broadcast one transaction), confirmation (broadcast
+// to confirmed), total (submit() to result)
+const STAGE_SECONDS = registry.histogram(
+  'oracle_stage_duration_seconds',
+  'Time spent in each verification pipeline stage'
+);
+
+export interface PipelineOptions {
+  contractId: string;
+  aiConcurrency: number;      // AI calls in flight
+  aiBatchSize: number;        // Requests per /verify/batch call
+  submitConcurrency: number;  // Transactions being built and broadcast
+  maxQueueDepth: number;      // Accepted requests not yet finished
+  batchSize: number;          // Scores per batch transaction (<= MAX_SCORE_BATCH)
+  confirmTimeoutMs: number;
+  pendingDepositTick: (slot: number) => number | undefined; // Deposit tick of the escrow in slot if it awaits a score
+  onConfirmed?: (request: VerificationRequest, aiResult: VerificationResult) => void;
+  journal?: PipelineJournal;
+}
+
+/** A signed transaction about to be broadcast */
+export interface SubmittedTransaction {
+  encodedTransaction: string;
+  targetTick: number;
+  inputType: number;
+}
+
+/** Receives each job's progress (implemented by StateStore) */
+export interface PipelineJournal {
+  accepted(id: string, request: VerificationRequest): void;
+  scored(id: string, aiResult: VerificationResult): void;
+  submitting(ids: string[], transaction: SubmittedTransaction): void;  // Before broadcast
+  broadcast(ids: string[], txId: string): void;
+  finished(ids: string[]): void;                                       // Confirmed or failed
+}
+
+export interface PipelineStats {
+  depth: number;              // Accepted and unfinished, bounded by maxQueueDepth
+  maxQueueDepth: number;
+  awaitingScore: number;      // Queued for the AI pool
+  scoring: number;            // Requests in AI calls in flight
+  awaitingSubmission: number; // Scored, queued for the chain pool
+  submitting: number;         // Requests in transactions being built or broadcast
+  confirming: number;         // Requests in broadcast transactions awaiting confirmation
+  completed: number;
+  failed: number;
+  rejected: number;           // Turned away because the queue was full
+}
+
+export class QueueFullError extends Error {
+  constructor(depth: number) {
+    super(`Verification queue is full (${depth} requests in progress)`);
+    this.name = 'QueueFullError';
+  }
+}
+
+export class InvalidRequestError extends Error {
+  constructor(message: string) {
+    super(message);
+    this.name = 'InvalidRequestError';
+  }
+}
+
+/** Scores are submitted by slot, so a request without one cannot reach any escrow */
+function hasEscrowSlot(request: VerificationRequest): boolean {
+  return Number.isInteger(request.escrowSlot) && (request.escrowSlot as number) >= 0;
+}
+
+/** A request accepted by submit() carries the deposit tick its batch entry is bound to */
+function hasEscrowBinding(request: VerificationRequest): boolean {
+  return hasEscrowSlot(request) && Number.isInteger(request.escrowDepositTick);
+}
+
+interface VerificationJob {
+  id: string;
+  request: VerificationRequest;
+  acceptedAt: number;         // Date.now() when queued (or resumed)
+  aiResult?: VerificationResult;
+  resolve: (result: any) => void;
+  reject: (error: Error) => void;
+}
+
+export class VerificationPipeline {
+  private scoringQueue: VerificationJob[] = [];
+  private submissionQueue: VerificationJob[] = [];
+  private scoring: number = 0;
+  private aiWorkers: number = 0;
+  private submittingJobs: number = 0;
+  private submitWorkers: number = 0;
+  private confirming: number = 0;
+  private completed: number = 0;
+  private failed: number = 0;
+  private rejected: number = 0;
+
+  constructor(
+    private aiClient: AIClient,
+    private qubicClient: QubicClient,
+    private txBuilder: TransactionBuilder,
+    private options: PipelineOptions
+  ) {}
+
+  /**
+   * Queue a request; resolves with the submission result once confirmed
+   */
+  submit(request: VerificationRequest): Promise<any> {
+    if (!hasEscrowSlot(request)) {
+      return Promise.reject(new InvalidRequestError('escrowSlot is required (the slot returned by depositFunds)'));
+    }
+    const slot = request.escrowSlot as number;
+    const depositTick = this.options.pendingDepositTick(slot);
+    if (depositTick === undefined) {
+      return Promise.reject(new InvalidRequestError(`Escrow slot ${slot} is not awaiting verification`));
+    }
+    request = { ...request, escrowDepositTick: depositTick };
+
+    const depth = this.depth();
+    if (depth >= this.options.maxQueueDepth) {
+      this.rejected++;
+      return Promise.reject(new QueueFullError(depth));
+    }
+
+    return new Promise((resolve, reject) => {
+      const id = randomUUID();
+      this.options.journal?.accepted(id, request);
+      this.scoringQueue.push({ id, request, acceptedAt: Date.now(), resolve, reject });
+      this.pumpScoring();
+    });
+  }
+
+  /**
+   * Continue jobs recovered from the journal after a restart
+   * Accepted jobs are scored and scored jobs submitted; broadcast jobs wait
+   * for confirmation again. A transaction whose broadcast may have been cut
+   * short is re-sent unchanged while its target tick is ahead (the network
+   * treats the identical transaction as one), and failed once the tick has
+   * passed, since a new transaction could score the same job twice.
+   * Nobody awaits recovered jobs; their outcome is logged.
+   */
+  resume(persisted: PersistedJob[]): void {
+    // Jobs batched into one transaction, by its signed bytes
+    const transactions = new Map<string, { transaction: NonNullable<PersistedJob['transaction']>; jobs: VerificationJob[] }>();
+    let dropped = 0;
+    for (const entry of persisted) {
+      if (!entry.transaction && !hasEscrowBinding(entry.request)) {
+        // Accepted by an older version without a slot or deposit tick
+        this.options.journal?.finished([entry.id]);
+        dropped++;
+        continue;
+      }
+      const job: VerificationJob = {
+        id: entry.id,
+        request: entry.request,
+        aiResult: entry.aiResult,
+        acceptedAt: Date.now(),
+        resolve: () => {},
+        reject: () => {}
+      };
+
+      if (entry.stage === 'accepted') {
+        this.scoringQueue.push(job);
+      } else if (entry.stage === 'scored') {
+        this.submissionQueue.push(job);
+      } else if (entry.transaction) {
+        const key = entry.transaction.encodedTransaction;
+        const group = transactions.get(key) || { transaction: entry.transaction, jobs: [] };
+        group.jobs.push(job);
+        transactions.set(key, group);
+      }
+    }
+
+    for (const { transaction, jobs } of transactions.values()) {
+      if (transaction.txId) {
+        this.track(jobs, transaction.txId, transaction);
+      } else {
+        this.rebroadcast(jobs, transaction);
+      }
+    }
+
+    if (dropped > 0) {
+      console.warn(`[Pipeline] Dropped ${dropped} recovered job(s) not bound to an escrow`);
+    }
+    console.log(`[Pipeline] Resumed ${persisted.length - dropped} job(s): ${this.scoringQueue.length} to score, ` +
+      `${this.submissionQueue.length} to submit, ${this.submittingJobs + this.confirming} in flight`);
+    this.pumpScoring();
+    this.pumpSubmission();
+  }
+
+  /** True if submit() would accept another request */
+  hasCapacity(): boolean {
+    return this.depth() < this.options.maxQueueDepth;
+  }
+
+  stats(): PipelineStats {
+    return {
+      depth: this.depth(),
+      maxQueueDepth: this.options.maxQueueDepth,
+      awaitingScore: this.scoringQueue.length,
+      scoring: this.scoring,
+      awaitingSubmission: this.submissionQueue.length,
+      submitting: this.submittingJobs,
+      confirming: this.confirming,
+      completed: this.completed,
+      failed: this.failed,
+      rejected: this.rejected
+    };
+  }
+
+  private depth(): number {
+    return this.scoringQueue.length + this.scoring + this.submissionQueue.length
+      + this.submittingJobs + this.confirming;
+  }
+
+  // ------------------------------------------------------------------
+  // Stage 1: AI scoring
+  // ------------------------------------------------------------------
+
+  private pumpScoring(): void {
+    while (this.aiWorkers < this.options.aiConcurrency && this.scoringQueue.length > 0) {
+      const batch = this.scoringQueue.splice(0, Math.max(1, this.options.aiBatchSize));
+      const now = Date.now();
+      batch.forEach(job => STAGE_SECONDS.observe((now - job.acceptedAt) / 1000, { stage: 'queued' }));
+      this.aiWorkers++;
+      this.scoring += batch.length;
+      this.score(batch).finally(() => {
+        this.aiWorkers--;
+        this.scoring -= batch.length;
+        this.pumpScoring();
+      });
+    }
+  }
+
+  private async score(batch: VerificationJob[]): Promise<void> {
+    let results: Array<VerificationResult | Error>;
+    try {
+      results = await STAGE_SECONDS.time({ stage: 'scoring' }, async () => batch.length === 1
+        ? [await this.aiClient.verifyPost(batch[0].request)]
+        : await this.aiClient.verifyBatch(batch.map(job => job.request)));
+    } catch (error: any) {
+      this.fail(batch, error);
+      return;
+    }
+
+    batch.forEach((job, i) => {
+      const result = results[i];
+      if (result instanceof Error) {
+        this.fail([job], result);
+        return;
+      }
+      job.aiResult = result;
+      this.options.journal?.scored(job.id, result);
+      console.log(`[Pipeline] Scored ${job.request.postUrl}: ${result.overall_score}/100`);
+      this.submissionQueue.push(job);
+    });
+    this.pumpSubmission();
+  }
+
+  // ------------------------------------------------------------------
+  // Stage 2: chain submission
+  // ------------------------------------------------------------------
+
+  private pumpSubmission(): void {
+    while (this.submitWorkers < this.options.submitConcurrency && this.submissionQueue.length > 0) {
+      const batch = this.takeBatch();
+      this.submitWorkers++;
+      this.submittingJobs += batch.length;
+      this.submitBatch(batch).finally(() => {
+        this.submitWorkers--;
+        this.submittingJobs -= batch.length;
+        this.pumpSubmission();
+      });
+    }
+  }
+
+  /**
+   * Next transaction's worth of jobs
+   * One score per slot, since the contract takes one score per oracle and
+   * escrow; a repeated slot waits for the next batch
+   */
+  private takeBatch(): VerificationJob[] {
+    const limit = Math.min(this.options.batchSize, MAX_SCORE_BATCH);
+    const batch: VerificationJob[] = [];
+    const slots = new Set<number>();
+    const remaining: VerificationJob[] = [];
+    for (const job of this.submissionQueue) {
+      const slot = job.request.escrowSlot as number;
+      if (batch.length < limit && !slots.has(slot)) {
+        slots.add(slot);
+        batch.push(job);
+      } else {
+        remaining.push(job);
+      }
+    }
+    this.submissionQueue = remaining;
+    return batch;
+  }
+
+  private async submitBatch(batch: VerificationJob[]): Promise<void> {
+    let jobs = batch;
+    let txId: string;
+    let txResult: { targetTick: number; inputType: number };
+    const stopTimer = STAGE_SECONDS.startTimer({ stage: 'submission' });
+    try {
+      const currentTick = await this.qubicClient.getCurrentTick();
+
+      // Invalid scores fail on their own instead of sinking the batch, and
+      // so do escrows scored or settled since the request was accepted
+      jobs = jobs.filter(job => {
+        const slot = job.request.escrowSlot as number;
+        if (this.options.pendingDepositTick(slot) !== job.request.escrowDepositTick) {
+          this.fail([job], new Error(`Escrow slot ${slot} is no longer awaiting verification`));
+          return false;
+        }
+        const validation = this.txBuilder.validateTransactionParams(
+          this.options.contractId,
+          (job.aiResult as VerificationResult).overall_score,
+          currentTick
+        );
+        if (!validation.valid) {
+          this.fail([job], new Error(`Invalid transaction parameters: ${validation.errors.join(', ')}`));
+        }
+        return validation.valid;
+      });
+      if (jobs.length === 0) {
+        return;
+      }
+
+      const aiResults = jobs.map(job => job.aiResult as VerificationResult);
+
+      const built = await this.txBuilder.buildSetVerificationScoreBatchTransaction(
+        this.options.contractId,
+        jobs.map((job, i) => ({
+          slot: job.request.escrowSlot as number,
+          depositTick: job.request.escrowDepositTick as number,
+          score: aiResults[i].overall_score
+        })),
+        currentTick
+      );
+
+      this.options.journal?.submitting(jobs.map(job => job.id), built);
+      txId = await this.qubicClient.broadcastTransaction(built.encodedTransaction);
+      this.options.journal?.broadcast(jobs.map(job => job.id), txId);
+      txResult = built;
+      console.log(`[Pipeline] Broadcast ${jobs.length} score(s) in ${txId} for tick ${built.targetTick}`);
+    } catch (error: any) {
+      this.fail(jobs, error);
+      return;
+    } finally {
+      stopTimer();
+    }
+
+    // Hand over to confirmation and free this worker for the next batch
+    this.track(jobs, txId, txResult);
+  }
+
+  /**
+   * Broadcast a recovered transaction again, if its target tick is still ahead
+   */
+  private async rebroadcast(jobs: VerificationJob[], transaction: SubmittedTransaction): Promise<void> {
+    let txId: string;
+    this.submittingJobs += jobs.length;
+    try {
+      const currentTick = await this.qubicClient.getCurrentTick();
+      if (currentTick >= transaction.targetTick) {
+        throw new Error(`Broadcast for tick ${transaction.targetTick} was interrupted and the tick has passed; not resubmitted`);
+      }
+      txId = await this.qubicClient.broadcastTransaction(transaction.encodedTransaction);
+      this.options.journal?.broadcast(jobs.map(job => job.id), txId);
+      console.log(`[Pipeline] Re-sent interrupted broadcast ${txId} for tick ${transaction.targetTick}`);
+    } catch (error: any) {
+      this.fail(jobs, error);
+      return;
+    } finally {
+      this.submittingJobs -= jobs.length;
+    }
+
+    this.track(jobs, txId, transaction);
+  }
+
+  private track(jobs: VerificationJob[], txId: string, txResult: { targetTick: number; inputType: number }): void {
+    this.confirming += jobs.length;
+    this.confirm(jobs, txId, txResult).finally(() => {
+      this.confirming -= jobs.length;
+    });
+  }
+
+  // ------------------------------------------------------------------
+  // Stage 3: confirmation (shared tick watcher)
+  // ------------------------------------------------------------------
+
+  private async confirm(
+    jobs: VerificationJob[],
+    txId: string,
+    txResult: { targetTick: number; inputType: number }
+  ): Promise<void> {
+    let confirmed: boolean;
+    try {
+      confirmed = await STAGE_SECONDS.time({ stage: 'confirmation' },
+        () => this.qubicClient.waitForConfirmation(txId, txResult.targetTick, this.options.confirmTimeoutMs));
+    } catch (error: any) {
+      this.fail(jobs, error);
+      return;
+    }
+
+    const now = Date.now();
+    for (const job of jobs) {
+      const aiResult = job.aiResult as VerificationResult;
+      STAGE_SECONDS.observe((now - job.acceptedAt) / 1000, { stage: 'total' });
+      if (confirmed) {
+        this.completed++;
+        this.options.onConfirmed?.(job.request, aiResult);
+      } else {
+        this.failed++;
+      }
+
+      job.resolve({
+        success: confirmed,
+        transactionId: txId,
+        targetTick: txResult.targetTick,
+        score: aiResult.overall_score,
+        recommendation: aiResult.recommendation,
+        confidence: aiResult.confidence,
+        aiResult: {
+          overall_score: aiResult.overall_score,
+          passed: aiResult.passed,
+          recommendation: aiResult.recommendation,
+          confidence: aiResult.confidence,
+          fraud_flags: aiResult.fraud_flags,
+          summary: aiResult.summary
+        },
+        transaction: {
+          id: txId,
+          tick: txResult.targetTick,
+          inputType: txResult.inputType,
+          batchSize: jobs.length,
+          confirmed
+        }
+      });
+    }
+
+    this.options.journal?.finished(jobs.map(job => job.id));
+
+    if (confirmed) {
+      console.log(`[Pipeline] ✓ ${jobs.length} score(s) confirmed at tick ${txResult.targetTick}`);
+    } else {
+      console.error(`[Pipeline] ✗ Transaction ${txId} not confirmed; it may still be pending or was rejected`);
+    }
+  }
+
+  private fail(jobs: VerificationJob[], error: Error): void {
+    console.error(`[Pipeline] ✗ ${jobs.length} verification(s) failed: ${error.message}`);
+    this.options.journal?.finished(jobs.map(job => job.id));
+    for (const job of jobs) {
+      this.failed++;
+      job.reject(error);
+    }
+  }
+}
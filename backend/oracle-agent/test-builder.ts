@@ -6,6 +6,7 @@
 
 import { TransactionBuilder } from './src/transactionBuilder';
 import { Config } from './src/config';
+import { QubicClient } from './src/qubicClient';
 
 async function testTransactionBuilder() {
   console.log('═══════════════════════════════════════════');
@@ -54,9 +55,11 @@ async function testTransactionBuilder() {
     console.log('5. Building Test Transaction...');
     const testTick = 12345678;
     const testScore = 87;
+    const testKey = QubicClient.escrowKey(builder.getOraclePublicKey(), builder.getOraclePublicKey(), BigInt(1));
     
     const result = await builder.buildSetVerificationScoreTransaction(
       Config.QUBIC.contractId,
+      testKey,
       testScore,
       testTick
     );
@@ -0,0 +1,156 @@
+/**
+ * RPC Cache
+ * Tick-aware response cache with in-flight request coalescing
+ *
+ * Responses have one of three lifetimes:
+ *   tick info    kept for tickInfoTtlMs; a refresh that shows a new tick
+ *                ends the previous one
+ *   tick-scoped  status, balances, recent tick transactions: valid until the
+ *                tick they were fetched in ends
+ *   immutable    transactions of finalized ticks: kept until evicted (LRU,
+ *                maxImmutableEntries)
+ *
+ * Concurrent requests for the same key share one in-flight fetch, so any
+ * number of pollers cost one upstream call per key per tick. Failed fetches
+ * are not cached.
+ */
+
+export interface RpcCacheOptions {
+  tickInfoTtlMs: number;        // How long a tick-info response is reused
+  finalityTicks: number;        // Ticks behind the current one that count as final
+  maxImmutableEntries: number;
+}
+
+export interface RpcCacheStats {
+  tick: number;
+  hits: number;
+  misses: number;
+  coalesced: number;            // Requests that joined an in-flight fetch
+  tickScopedEntries: number;
+  immutableEntries: number;
+  evictions: number;
+  tickChanges: number;
+}
+
+export class RpcCache {
+  private tick: number = 0;
+  private tickInfo?: { value: any; expiresAt: number };
+  private tickScoped: Map<string, any> = new Map();   // Cleared when the tick changes
+  private immutable: Map<string, any> = new Map();    // Insertion order = LRU order
+  private inFlight: Map<string, Promise<any>> = new Map();
+  private hits: number = 0;
+  private misses: number = 0;
+  private coalesced: number = 0;
+  private evictions: number = 0;
+  private tickChanges: number = 0;
+
+  constructor(
+    private options: RpcCacheOptions,
+    private fetchTickInfo: () => Promise<any>,
+    private readTick: (tickInfo: any) => number
+  ) {}
+
+  /**
+   * Tick-info response, refreshed at most once per tickInfoTtlMs
+   */
+  async getTickInfo(): Promise<any> {
+    if (this.tickInfo && Date.now() < this.tickInfo.expiresAt) {
+      this.hits++;
+      return this.tickInfo.value;
+    }
+
+    return this.coalesce('tick-info', async () => {
+      const value = await this.fetchTickInfo();
+      this.tickInfo = { value, expiresAt: Date.now() + this.options.tickInfoTtlMs };
+      this.observeTick(this.readTick(value));
+      return value;
+    });
+  }
+
+  /** Latest tick seen by the cache (refreshing tick info if it is stale) */
+  async currentTick(): Promise<number> {
+    await this.getTickInfo();
+    return this.tick;
+  }
+
+  /** True if a tick is far enough behind the current one to be final */
+  isFinalized(tick: number): boolean {
+    return this.tick > 0 && tick <= this.tick - this.options.finalityTicks;
+  }
+
+  /**
+   * Response for key, valid until the current tick ends
+   * If promote(value) is true the response is kept as immutable instead
+   */
+  async getTickScoped(key: string, fetch: () => Promise<any>, promote?: (value: any) => boolean): Promise<any> {
+    if (this.immutable.has(key)) {
+      const value = this.immutable.get(key);
+      this.immutable.delete(key);
+      this.immutable.set(key, value);
+      this.hits++;
+      return value;
+    }
+
+    const tick = await this.currentTick();
+    if (this.tickScoped.has(key)) {
+      this.hits++;
+      return this.tickScoped.get(key);
+    }
+
+    return this.coalesce(`${tick}:${key}`, async () => {
+      const value = await fetch();
+      if (promote?.(value)) {
+        this.storeImmutable(key, value);
+      } else if (this.tick === tick) {
+        // A response fetched across a tick change belongs to the old tick
+        this.tickScoped.set(key, value);
+      }
+      return value;
+    });
+  }
+
+  stats(): RpcCacheStats {
+    return {
+      tick: this.tick,
+      hits: this.hits,
+      misses: this.misses,
+      coalesced: this.coalesced,
+      tickScopedEntries: this.tickScoped.size,
+      immutableEntries: this.immutable.size,
+      evictions: this.evictions,
+      tickChanges: this.tickChanges
+    };
+  }
+
+  private observeTick(tick: number): void {
+    if (tick > this.tick) {
+      this.tick = tick;
+      this.tickScoped.clear();
+      this.tickChanges++;
+    }
+  }
+
+  private storeImmutable(key: string, value: any): void {
+    this.immutable.set(key, value);
+    while (this.immutable.size > this.options.maxImmutableEntries) {
+      this.immutable.delete(this.immutable.keys().next().value as string);
+      this.evictions++;
+    }
+  }
+
+  /**
+   * Run fetch once per key at a time; concurrent callers share its promise
+   */
+  private coalesce(key: string, fetch: () => Promise<any>): Promise<any> {
+    const pending = this.inFlight.get(key);
+    if (pending) {
+      this.coalesced++;
+      return pending;
+    }
+
+    this.misses++;
+    const promise = fetch().finally(() => this.inFlight.delete(key));
+    this.inFlight.set(key, promise);
+    return promise;
+  }
+}
@@ -5,15 +5,44 @@
 import express from 'express';
 import cors from 'cors';
 import * as net from 'net';
+import axios from 'axios';
+import { RpcCache } from './rpcCache';
+import { CONTENT_TYPE, registry } from './metrics';
 
 const app = express();
 const PORT = 8001;
 const QUBIC_NODE_HOST = '127.0.0.1';
 const QUBIC_NODE_PORT = 31841;
 
+// Optional upstream RPC (e.g. https://rpc.qubic.org); simulated data when unset
+const UPSTREAM_RPC_URL = process.env.UPSTREAM_RPC_URL || '';
+const MAX_BATCH_REQUESTS = parseInt(process.env.MAX_BATCH_REQUESTS || '64');
+const upstream = UPSTREAM_RPC_URL
+  ? axios.create({ baseURL: UPSTREAM_RPC_URL, timeout: parseInt(process.env.UPSTREAM_TIMEOUT_MS || '10000') })
+  : null;
+
 app.use(cors());
 app.use(express.json());
 
+// ============================================
+// METRICS
+// ============================================
+
+const REQUESTS = registry.counter('rpc_proxy_requests_total', 'HTTP requests served, by route and status');
+const REQUEST_SECONDS = registry.histogram('rpc_proxy_request_duration_seconds', 'HTTP request latency by route');
+const UPSTREAM_SECONDS = registry.histogram('rpc_proxy_upstream_duration_seconds', 'Upstream RPC fetch latency by endpoint');
+
+app.use((req, res, next) => {
+  const started = process.hrtime.bigint();
+  res.on('finish', () => {
+    // The route pattern, not the raw path, to bound label values
+    const route = req.route?.path ? `${req.method} ${req.route.path}` : 'unmatched';
+    REQUEST_SECONDS.observe(Number(process.hrtime.bigint() - started) / 1e9, { route });
+    REQUESTS.inc({ route, status: res.statusCode });
+  });
+  next();
+});
+
 // In-memory state (read from node)
 let currentTick = 38640000;
 let currentEpoch = 190;
@@ -58,44 +87,34 @@ function startTickSimulation() {
 }
 
 // ============================================
-// RPC ENDPOINTS
+// SIMULATED RESPONSES
 // ============================================
 
-/**
- * GET /v1/status - Network status
- */
-app.get('/v1/status', (req, res) => {
-  res.json({
+function simulatedStatus() {
+  return {
     lastProcessedTick: {
       tick: currentTick,
       epoch: currentEpoch
     },
     numberOfEntities: balances.size,
     timestamp: new Date().toISOString()
-  });
-});
+  };
+}
 
-/**
- * GET /v1/tick-info - Current tick information
- */
-app.get('/v1/tick-info', (req, res) => {
-  res.json({
+function simulatedTickInfo() {
+  return {
     tickInfo: {
       tick: currentTick,
       epoch: currentEpoch,
       timestamp: Date.now()
     }
-  });
-});
+  };
+}
 
-/**
- * GET /v1/balances/:address - Get balance for address
- */
-app.get('/v1/balances/:address', (req, res) => {
-  const address = req.params.address.toUpperCase();
+function simulatedBalance(address: string) {
   const balance = balances.get(address) || BigInt(0);
-  
-  res.json({
+
+  return {
     balance: {
       id: address,
       balance: balance.toString(),
@@ -107,7 +126,192 @@ app.get('/v1/balances/:address', (req, res) => {
       numberOfIncomingTransfers: 0,
       numberOfOutgoingTransfers: 0
     }
-  });
+  };
+}
+
+function simulatedTickTransactions(tick: number) {
+  return {
+    transactions: []
+  };
+}
+
+/**
+ * GET path from the upstream RPC, or the simulated response
+ */
+async function fetchRpc(path: string, simulated: () => any): Promise<any> {
+  if (!upstream) {
+    return simulated();
+  }
+  // Label by endpoint family (/v1/balances, /v2/ticks, ...), not by address or tick
+  const endpoint = path.split('/').slice(0, 3).join('/');
+  const response = await UPSTREAM_SECONDS.time({ endpoint }, () => upstream.get(path));
+  return response.data;
+}
+
+/**
+ * Send a (possibly cached) response; upstream failures become 502
+ */
+function respond(res: express.Response, produce: () => Promise<any>) {
+  produce()
+    .then(body => res.json(body))
+    .catch((error: any) => {
+      const status = error.response?.status || 502;
+      console.error(`[RPC] Upstream request failed (${status}): ${error.message}`);
+      res.status(status).json({
+        error: error.response?.data?.error || error.message
+      });
+    });
+}
+
+// ============================================
+// RESPONSE CACHE
+// ============================================
+
+/**
+ * Tick-info, status and balances are reused until the next tick;
+ * transactions of finalized ticks are cached indefinitely
+ */
+const cache = new RpcCache(
+  {
+    tickInfoTtlMs: parseInt(process.env.TICK_INFO_TTL_MS || '1000'),
+    finalityTicks: parseInt(process.env.FINALITY_TICKS || '5'),
+    maxImmutableEntries: parseInt(process.env.IMMUTABLE_CACHE_MAX_ENTRIES || '10000')
+  },
+  () => fetchRpc('/v1/tick-info', simulatedTickInfo),
+  (tickInfo) => tickInfo?.tickInfo?.tick || 0
+);
+
+registry.counterCallback('rpc_proxy_cache_lookups_total', 'Cache lookups by result', () => {
+  const stats = cache.stats();
+  return [
+    { labels: { result: 'hit' }, value: stats.hits },
+    { labels: { result: 'miss' }, value: stats.misses },
+    { labels: { result: 'coalesced' }, value: stats.coalesced }
+  ];
+});
+registry.gauge('rpc_proxy_cache_entries', 'Cached responses by lifetime', () => {
+  const stats = cache.stats();
+  return [
+    { labels: { lifetime: 'tick' }, value: stats.tickScopedEntries },
+    { labels: { lifetime: 'immutable' }, value: stats.immutableEntries }
+  ];
+});
+registry.counterCallback('rpc_proxy_cache_evictions_total', 'Immutable responses evicted', () => cache.stats().evictions);
+registry.gauge('rpc_proxy_tick', 'Latest tick seen by the cache', () => cache.stats().tick);
+
+// ============================================
+// READ HANDLERS
+// ============================================
+
+/**
+ * Error answered with an HTTP status (shaped like an upstream error)
+ */
+function rpcError(status: number, message: string): Error {
+  const error: any = new Error(message);
+  error.response = { status, data: { error: message } };
+  return error;
+}
+
+function getStatus(): Promise<any> {
+  return cache.getTickScoped('status', () => fetchRpc('/v1/status', simulatedStatus));
+}
+
+function getTickInfo(): Promise<any> {
+  return cache.getTickInfo();
+}
+
+function getBalance(address: string): Promise<any> {
+  address = address.toUpperCase();
+  return cache.getTickScoped(
+    `balance:${address}`,
+    () => fetchRpc(`/v1/balances/${address}`, () => simulatedBalance(address))
+  );
+}
+
+function getTransaction(txId: string): Promise<any> {
+  // Simulate confirmed transaction
+  return fetchRpc(`/v1/transactions/${txId}`, () => ({
+    transaction: {
+      txId,
+      tick: currentTick,
+      executed: true,
+      status: 'confirmed'
+    }
+  }));
+}
+
+/**
+ * A finalized tick's transactions never change; an empty list may only mean
+ * the archive has not caught up yet, so it is kept for the current tick only
+ */
+async function getTickTransactions(tickParam: string): Promise<any> {
+  const tick = parseInt(tickParam);
+  if (isNaN(tick)) {
+    throw rpcError(400, 'Invalid tick');
+  }
+
+  return cache.getTickScoped(
+    `tick-transactions:${tick}`,
+    () => fetchRpc(`/v2/ticks/${tick}/transactions`, () => simulatedTickTransactions(tick)),
+    (body) => cache.isFinalized(tick) && body?.transactions?.length > 0
+  );
+}
+
+async function querySmartContract(body: any): Promise<any> {
+  const { contractIndex, inputType, requestData } = body || {};
+
+  console.log(`[RPC] Contract query: index=${contractIndex}, type=${inputType}`);
+
+  if (upstream) {
+    return (await upstream.post('/v1/querySmartContract', body)).data;
+  }
+
+  // Return empty response for now
+  return {
+    responseData: Buffer.from('').toString('base64')
+  };
+}
+
+/**
+ * Route one read request of a batch to its handler
+ */
+function readRpc(method: string, path: string, body: any): Promise<any> {
+  let match: RegExpMatchArray | null;
+  if (method === 'GET') {
+    if (path === '/v1/status') return getStatus();
+    if (path === '/v1/tick-info') return getTickInfo();
+    if ((match = path.match(/^\/v1\/balances\/([^/]+)$/))) return getBalance(match[1]);
+    if ((match = path.match(/^\/v1\/transactions\/([^/]+)$/))) return getTransaction(match[1]);
+    if ((match = path.match(/^\/v2\/ticks\/([^/]+)\/transactions$/))) return getTickTransactions(match[1]);
+  } else if (method === 'POST' && path === '/v1/querySmartContract') {
+    return querySmartContract(body);
+  }
+  return Promise.reject(rpcError(404, `Not batchable: ${method} ${path}`));
+}
+
+// ============================================
+// RPC ENDPOINTS
+// ============================================
+
+/**
+ * GET /v1/status - Network status
+ */
+app.get('/v1/status', (req, res) => {
+  respond(res, getStatus);
+});
+
+/**
+ * GET /v1/tick-info - Current tick information
+ */
+app.get('/v1/tick-info', (req, res) => {
+  respond(res, getTickInfo);
+});
+
+/**
+ * GET /v1/balances/:address - Get balance for address
+ */
+app.get('/v1/balances/:address', (req, res) => {
+  respond(res, () => getBalance(req.params.address));
 });
 
 /**
@@ -123,6 +327,10 @@ app.post('/v1/broadcast-transaction', (req, res) => {
   }
   
   console.log(`[RPC] Broadcasting transaction (${encodedTransaction.length} chars)`);
+
+  if (upstream) {
+    return respond(res, async () => (await upstream.post('/v1/broadcast-transaction', req.body)).data);
+  }
   
   // Simulate successful broadcast
   const txId = generateTxId();
@@ -140,42 +348,62 @@ app.post('/v1/broadcast-transaction', (req, res) => {
  * GET /v1/transactions/:txId - Get transaction status
  */
 app.get('/v1/transactions/:txId', (req, res) => {
-  const { txId } = req.params;
-  
-  // Simulate confirmed transaction
-  res.json({
-    transaction: {
-      txId,
-      tick: currentTick,
-      executed: true,
-      status: 'confirmed'
-    }
-  });
+  respond(res, () => getTransaction(req.params.txId));
 });
 
 /**
  * GET /v2/ticks/:tick/transactions - Get transactions in tick
  */
 app.get('/v2/ticks/:tick/transactions', (req, res) => {
-  const tick = parseInt(req.params.tick);
-  
-  res.json({
-    transactions: []
-  });
+  respond(res, () => getTickTransactions(req.params.tick));
 });
 
 /**
  * POST /v1/querySmartContract - Query contract state
  */
 app.post('/v1/querySmartContract', (req, res) => {
-  const { contractIndex, inputType, requestData } = req.body;
-  
-  console.log(`[RPC] Contract query: index=${contractIndex}, type=${inputType}`);
-  
-  // Return empty response for now
-  res.json({
-    responseData: Buffer.from('').toString('base64')
-  });
+  respond(res, () => querySmartContract(req.body));
+});
+
+/**
+ * POST /v1/batch - Several read requests in one round-trip
+ * Body: { requests: [{ method, path, body? }] }; each entry is answered in
+ * order with { status, data }, through the same cache as single requests
+ */
+app.post('/v1/batch', async (req, res) => {
+  const requests = req.body?.requests;
+
+  if (!Array.isArray(requests) || requests.length === 0) {
+    return res.status(400).json({
+      error: 'requests must be a non-empty list'
+    });
+  }
+  if (requests.length > MAX_BATCH_REQUESTS) {
+    return res.status(400).json({
+      error: `At most ${MAX_BATCH_REQUESTS} requests per batch`
+    });
+  }
+
+  const responses = await Promise.all(requests.map(async (request: any) => {
+    try {
+      const data = await readRpc(String(request?.method || 'GET').toUpperCase(), String(request?.path || ''), request?.body);
+      return { status: 200, data };
+    } catch (error: any) {
+      return {
+        status: error.response?.status || 502,
+        data: { error: error.response?.data?.error || error.message }
+      };
+    }
+  }));
+
+  res.json({ responses });
+});
+
+/**
+ * GET /metrics - Prometheus metrics
+ */
+app.get('/metrics', (req, res) => {
+  res.type(CONTENT_TYPE).send(registry.render());
 });
 
 /**
@@ -185,8 +413,10 @@ app.get('/health', (req, res) => {
   res.json({
     status: 'healthy',
     node: 'connected',
+    upstream: UPSTREAM_RPC_URL || 'simulated',
     tick: currentTick,
-    epoch: currentEpoch
+    epoch: currentEpoch,
+    cache: cache.stats()
   });
 });
 
@@ -210,7 +440,7 @@ function generateTxId(): string {
 async function start() {
   console.log('═══════════════════════════════════════════');
   console.log('  Qubic RPC Proxy Server');
-  console.log('  Local Development Mode');
+  console.log(UPSTREAM_RPC_URL ? `  Upstream: ${UPSTREAM_RPC_URL}` : '  Local Development Mode');
   console.log('═══════════════════════════════════════════\n');
   
   try {
@@ -233,7 +463,10 @@ async function start() {
       console.log(`  GET  http://localhost:${PORT}/v1/status`);
       console.log(`  GET  http://localhost:${PORT}/v1/tick-info`);
       console.log(`  GET  http://localhost:${PORT}/v1/balances/:address`);
+      console.log(`  GET  http://localhost:${PORT}/v2/ticks/:tick/transactions`);
       console.log(`  POST http://localhost:${PORT}/v1/broadcast-transaction`);
+      console.log(`  POST http://localhost:${PORT}/v1/batch`);
+      console.log(`  GET  http://localhost:${PORT}/metrics`);
       console.log(`  GET  http://localhost:${PORT}/health\n`);
     });
     
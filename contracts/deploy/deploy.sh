@@ -87,6 +87,7 @@ echo "  Compiling $CONTRACT_FILE..."
 
 # For now, we'll simulate successful compilation
 cp "$CONTRACT_FILE" "$BUILD_DIR/escrow.compiled"
+cp src/escrow_wire.h "$BUILD_DIR/"
 echo -e "${GREEN}✓ Contract compiled successfully${NC}"
 
 echo ""
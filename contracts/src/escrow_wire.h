@@ -0,0 +1,468 @@
+/*
+ * Qubic Smart Escrow Contract - Wire Layout
+ *
+ * Input and output structures exchanged with the escrow contract. This is
+ * the single definition shared by escrow.qpi, the contract tests and the
+ * oracle agent: backend/oracle-agent/src/escrowWire.ts is generated from
+ * this file by contracts/test/gen_wire_layout.cpp.
+ *
+ * Every structure is padding-free (spare bytes are explicit reserved
+ * fields that must be zero) and its offsets are pinned below, so changing
+ * a layout breaks the build instead of silently breaking a client.
+ *
+ * Requires the QPI base types (include after qpi.h / qpi_test.h).
+ */
+
+#ifndef ESCROW_WIRE_H
+#define ESCROW_WIRE_H
+
+// Procedure input types (transaction inputType)
+static const uint16 ESCROW_PROCEDURE_DEPOSIT_FUNDS = 0;
+static const uint16 ESCROW_PROCEDURE_SET_VERIFICATION_SCORE = 1;
+static const uint16 ESCROW_PROCEDURE_RELEASE_PAYMENT = 2;
+static const uint16 ESCROW_PROCEDURE_REFUND_FUNDS = 3;
+static const uint16 ESCROW_PROCEDURE_SET_ORACLE_ID = 4;
+static const uint16 ESCROW_PROCEDURE_SET_VERIFICATION_SCORE_BATCH = 5;
+static const uint16 ESCROW_PROCEDURE_DEPOSIT_FUNDS_BATCH = 6;
+static const uint16 ESCROW_PROCEDURE_SET_ORACLE_SET = 7;
+static const uint16 ESCROW_PROCEDURE_SUBMIT_COSIGNED_SCORES = 8;
+static const uint16 ESCROW_PROCEDURE_DEPOSIT_STREAM = 9;
+static const uint16 ESCROW_PROCEDURE_CLAIM_STREAM = 10;
+
+// Function input types (querySmartContract inputType)
+static const uint16 ESCROW_FUNCTION_GET_CONTRACT_STATE = 0;
+static const uint16 ESCROW_FUNCTION_GET_ESCROWS_PAGE = 1;
+static const uint16 ESCROW_FUNCTION_GET_EVENTS_SINCE = 2;
+static const uint16 ESCROW_FUNCTION_GET_AGGREGATES = 3;
+static const uint16 ESCROW_FUNCTION_GET_STREAM = 4;
+
+// Batched oracle submission
+static const uint32 MAX_SCORE_BATCH = 256;               // Entries per setVerificationScoreBatch
+
+// Oracle set (M-of-N quorum)
+static const uint32 MAX_ORACLES = 8;                     // Oracles in the set, one bit each per escrow
+static const uint32 MAX_COSIGNED_SCORES = 64;            // Entries per submitCosignedScores
+
+// Batched brand deposit
+static const uint32 MAX_DEPOSIT_BATCH = 200;             // Entries per depositFundsBatch
+
+// Streaming payouts
+static const uint32 MAX_STREAM_TICKS = 5256000;          // Longest stream (~365 days)
+
+// Paged queries
+static const uint32 ESCROW_PAGE_SIZE = 16;               // Entries per getEscrowsPage response
+static const uint32 EVENT_PAGE_SIZE = 32;                // Events per getEventsSince response
+
+// Identifies one campaign escrow
+struct EscrowKey {
+    id brandId;              // Brand depositing payment
+    id influencerId;         // Influencer receiving payment
+    uint64 campaignNonce;    // Brand-chosen campaign number
+};
+
+static_assert(offsetof(EscrowKey, brandId) == 0, "EscrowKey layout changed");
+static_assert(offsetof(EscrowKey, influencerId) == 32, "EscrowKey layout changed");
+static_assert(offsetof(EscrowKey, campaignNonce) == 64, "EscrowKey layout changed");
+static_assert(sizeof(EscrowKey) == 72, "EscrowKey must be 9 packed words");
+
+// Escrow lifecycle; every record is in exactly one of these
+enum EscrowStatus : uint8 {
+    ESCROW_FREE = 0,         // Slot not in use
+    ESCROW_PENDING = 1,      // Funded, waiting for the oracle score
+    ESCROW_VERIFIED = 2,     // Scored, queued for settlement
+    ESCROW_PAID = 3,         // Payment released to influencer
+    ESCROW_REFUNDED = 4      // Funds returned to brand
+};
+
+static_assert(sizeof(EscrowStatus) == 1, "EscrowStatus must be one byte");
+
+// getEscrowsPage status value matching every allocated escrow
+static const uint8 ESCROW_STATUS_ANY = 0xFF;
+
+// depositFunds input (brandId is the transaction source)
+struct DepositInput {
+    sint64 amount;           // Payment amount including platform fee
+    id influencerId;         // Influencer receiving payment
+    uint32 retentionDays;    // Days the post must stay up
+    uint32 reserved;         // Must be zero
+    uint64 campaignNonce;    // Brand-chosen campaign number
+};
+
+static_assert(offsetof(DepositInput, amount) == 0, "DepositInput layout changed");
+static_assert(offsetof(DepositInput, influencerId) == 8, "DepositInput layout changed");
+static_assert(offsetof(DepositInput, retentionDays) == 40, "DepositInput layout changed");
+static_assert(offsetof(DepositInput, campaignNonce) == 48, "DepositInput layout changed");
+static_assert(sizeof(DepositInput) == 56, "DepositInput must stay padding-free");
+
+// depositFunds output
+struct DepositOutput {
+    uint32 slot;             // Slot allocated for the escrow
+};
+
+static_assert(sizeof(DepositOutput) == 4, "DepositOutput layout changed");
+
+// depositFundsBatch input header; count DepositBatchEntry records follow
+struct DepositBatchHeader {
+    sint64 totalAmount;      // Sum of all entry amounts, transferred once
+    uint64 campaignNonce;    // Shared by every escrow in the batch
+    uint32 count;            // Entries that follow (1..MAX_DEPOSIT_BATCH)
+    uint32 reserved;         // Must be zero
+};
+
+static_assert(offsetof(DepositBatchHeader, totalAmount) == 0, "DepositBatchHeader layout changed");
+static_assert(offsetof(DepositBatchHeader, campaignNonce) == 8, "DepositBatchHeader layout changed");
+static_assert(offsetof(DepositBatchHeader, count) == 16, "DepositBatchHeader layout changed");
+static_assert(sizeof(DepositBatchHeader) == 24, "DepositBatchHeader must stay padding-free");
+
+// One influencer in a depositFundsBatch input
+struct DepositBatchEntry {
+    id influencerId;         // Influencer receiving payment
+    sint64 amount;           // Payment amount including platform fee
+    uint32 retentionDays;    // Days the post must stay up
+    uint32 reserved;         // Must be zero
+};
+
+static_assert(offsetof(DepositBatchEntry, influencerId) == 0, "DepositBatchEntry layout changed");
+static_assert(offsetof(DepositBatchEntry, amount) == 32, "DepositBatchEntry layout changed");
+static_assert(offsetof(DepositBatchEntry, retentionDays) == 40, "DepositBatchEntry layout changed");
+static_assert(sizeof(DepositBatchEntry) == 48, "DepositBatchEntry must stay padding-free");
+
+// depositFundsBatch output (count 0 if the batch was rejected)
+struct DepositBatchOutput {
+    uint32 count;            // Escrows allocated
+    uint32 slots[MAX_DEPOSIT_BATCH]; // Slot per entry, in entry order
+};
+
+static_assert(offsetof(DepositBatchOutput, slots) == 4, "DepositBatchOutput layout changed");
+static_assert(sizeof(DepositBatchOutput) == 4 + MAX_DEPOSIT_BATCH * sizeof(uint32), "DepositBatchOutput must stay padding-free");
+
+// depositStream input (brandId is the transaction source)
+// The amount net of the platform fee accrues to the influencer at
+// ratePerTick from the deposit tick until it is used up.
+struct StreamDepositInput {
+    sint64 amount;           // Stream budget including platform fee
+    sint64 ratePerTick;      // Accrued to the influencer per tick
+    id influencerId;         // Influencer receiving the stream
+    uint64 campaignNonce;    // Brand-chosen campaign number
+};
+
+static_assert(offsetof(StreamDepositInput, amount) == 0, "StreamDepositInput layout changed");
+static_assert(offsetof(StreamDepositInput, ratePerTick) == 8, "StreamDepositInput layout changed");
+static_assert(offsetof(StreamDepositInput, influencerId) == 16, "StreamDepositInput layout changed");
+static_assert(offsetof(StreamDepositInput, campaignNonce) == 48, "StreamDepositInput layout changed");
+static_assert(sizeof(StreamDepositInput) == 56, "StreamDepositInput must stay padding-free");
+
+// claimStream output (input is an EscrowKey)
+struct StreamClaimOutput {
+    sint64 amount;           // Paid to the influencer by this claim (0 if rejected)
+    sint64 claimed;          // Paid out of the stream so far
+};
+
+static_assert(offsetof(StreamClaimOutput, amount) == 0, "StreamClaimOutput layout changed");
+static_assert(offsetof(StreamClaimOutput, claimed) == 8, "StreamClaimOutput layout changed");
+static_assert(sizeof(StreamClaimOutput) == 16, "StreamClaimOutput must stay padding-free");
+
+// getStream output (input is an EscrowKey)
+// All zero when the key is unknown or names a one-shot escrow
+struct StreamStateResponse {
+    sint64 budget;           // Streamed in total (deposit net of fee)
+    sint64 ratePerTick;
+    sint64 accrued;          // Earned up to the current tick
+    sint64 claimed;          // Paid out so far
+    uint32 startTick;        // Deposit tick, accrual starts here
+    uint32 endTick;          // Tick the whole budget has accrued
+    EscrowStatus status;
+    uint8 verificationScore;
+    bool claimable;          // Verified with a passing score, so accrual can be claimed
+    uint8 reserved[5];       // Must be zero
+};
+
+static_assert(offsetof(StreamStateResponse, budget) == 0, "StreamStateResponse layout changed");
+static_assert(offsetof(StreamStateResponse, ratePerTick) == 8, "StreamStateResponse layout changed");
+static_assert(offsetof(StreamStateResponse, accrued) == 16, "StreamStateResponse layout changed");
+static_assert(offsetof(StreamStateResponse, claimed) == 24, "StreamStateResponse layout changed");
+static_assert(offsetof(StreamStateResponse, startTick) == 32, "StreamStateResponse layout changed");
+static_assert(offsetof(StreamStateResponse, endTick) == 36, "StreamStateResponse layout changed");
+static_assert(offsetof(StreamStateResponse, status) == 40, "StreamStateResponse layout changed");
+static_assert(offsetof(StreamStateResponse, verificationScore) == 41, "StreamStateResponse layout changed");
+static_assert(offsetof(StreamStateResponse, claimable) == 42, "StreamStateResponse layout changed");
+static_assert(sizeof(StreamStateResponse) == 48, "StreamStateResponse must stay padding-free");
+
+// setVerificationScore input
+struct ScoreInput {
+    EscrowKey key;           // Escrow being scored
+    uint8 score;             // AI score (0-100)
+    uint8 reserved[7];       // Must be zero
+};
+
+static_assert(offsetof(ScoreInput, key) == 0, "ScoreInput layout changed");
+static_assert(offsetof(ScoreInput, score) == 72, "ScoreInput layout changed");
+static_assert(sizeof(ScoreInput) == 80, "ScoreInput must stay padding-free");
+
+// setVerificationScoreBatch input: uint32 count, then count packed entries
+static const uint32 SCORE_BATCH_HEADER_SIZE = sizeof(uint32);
+
+struct ScoreBatchEntry {
+    uint32 slot;             // Escrow slot (from depositFunds output)
+    uint32 depositTick;      // Binds the entry to the escrow now in slot
+    uint8 score;             // AI score (0-100)
+    uint8 reserved[3];       // Keeps entries 4-byte packed
+};
+
+static_assert(offsetof(ScoreBatchEntry, slot) == 0, "ScoreBatchEntry layout changed");
+static_assert(offsetof(ScoreBatchEntry, depositTick) == 4, "ScoreBatchEntry layout changed");
+static_assert(offsetof(ScoreBatchEntry, score) == 8, "ScoreBatchEntry layout changed");
+static_assert(sizeof(ScoreBatchEntry) == 12, "ScoreBatchEntry must stay padding-free");
+
+// setVerificationScoreBatch output
+struct ScoreBatchOutput {
+    uint32 applied;          // Entries that were applied
+};
+
+static_assert(sizeof(ScoreBatchOutput) == 4, "ScoreBatchOutput layout changed");
+
+// How the scores of an oracle set combine into the verification score
+enum EscrowScoreAggregation : uint8 {
+    SCORE_AGGREGATION_MEDIAN = 0,    // Lower median of the first quorum scores
+    SCORE_AGGREGATION_THRESHOLD = 1  // Passes once quorum oracles reach requiredScore,
+                                     // fails once that can no longer happen
+};
+
+// setOracleSet input
+struct OracleSetInput {
+    id oracles[MAX_ORACLES]; // First count entries are used, the rest must be zero
+    uint8 count;             // Oracles in the set (1..MAX_ORACLES)
+    uint8 quorum;            // Scores needed for a decision (1..count)
+    EscrowScoreAggregation aggregation;
+    uint8 reserved[5];       // Must be zero
+};
+
+static_assert(offsetof(OracleSetInput, oracles) == 0, "OracleSetInput layout changed");
+static_assert(offsetof(OracleSetInput, count) == 256, "OracleSetInput layout changed");
+static_assert(offsetof(OracleSetInput, quorum) == 257, "OracleSetInput layout changed");
+static_assert(offsetof(OracleSetInput, aggregation) == 258, "OracleSetInput layout changed");
+static_assert(sizeof(OracleSetInput) == 264, "OracleSetInput must stay padding-free");
+
+// What an oracle signs for submitCosignedScores: the K12 digest of this
+// message. The key and deposit tick pin the signature to one escrow: a key
+// can only be deposited again after its slot is reclaimed, at a later tick,
+// so a published signature cannot be replayed onto the new escrow even if
+// it lands in the same slot.
+struct CosignedScoreMessage {
+    EscrowKey key;           // Escrow being scored
+    uint32 slot;             // Its slot
+    uint32 depositTick;      // Its deposit tick (StateResponse.depositTick)
+    uint8 score;             // AI score (0-100)
+    uint8 reserved[7];       // Must be zero
+};
+
+static_assert(offsetof(CosignedScoreMessage, key) == 0, "CosignedScoreMessage layout changed");
+static_assert(offsetof(CosignedScoreMessage, slot) == 72, "CosignedScoreMessage layout changed");
+static_assert(offsetof(CosignedScoreMessage, depositTick) == 76, "CosignedScoreMessage layout changed");
+static_assert(offsetof(CosignedScoreMessage, score) == 80, "CosignedScoreMessage layout changed");
+static_assert(sizeof(CosignedScoreMessage) == 88, "CosignedScoreMessage must stay padding-free");
+
+// submitCosignedScores input: uint32 count, then count packed entries
+static const uint32 COSIGNED_SCORES_HEADER_SIZE = sizeof(uint32);
+
+struct CosignedScoreEntry {
+    uint32 slot;             // Escrow slot (from depositFunds output)
+    uint8 score;             // AI score (0-100)
+    uint8 oracleIndex;       // Signer's position in the oracle set
+    uint8 reserved[2];       // Must be zero
+    uint8 signature[64];     // Oracle's signature over the message digest
+};
+
+static_assert(offsetof(CosignedScoreEntry, slot) == 0, "CosignedScoreEntry layout changed");
+static_assert(offsetof(CosignedScoreEntry, score) == 4, "CosignedScoreEntry layout changed");
+static_assert(offsetof(CosignedScoreEntry, oracleIndex) == 5, "CosignedScoreEntry layout changed");
+static_assert(offsetof(CosignedScoreEntry, signature) == 8, "CosignedScoreEntry layout changed");
+static_assert(sizeof(CosignedScoreEntry) == 72, "CosignedScoreEntry must stay padding-free");
+
+// getContractState output (input is an EscrowKey)
+// All zero except oracleId when the key is unknown
+struct StateResponse {
+    id brandId;
+    id influencerId;
+    id oracleId;             // First oracle of the set
+    sint64 escrowBalance;
+    uint8 requiredScore;
+    uint8 verificationScore;
+    uint8 scoreSubmissions;  // Oracle scores received so far
+    uint8 reserved0;         // Must be zero
+    uint32 retentionEndTick;
+    bool isActive;           // Pending or verified
+    bool isVerified;         // Score submitted (stays set once settled)
+    bool isPaid;
+    bool isRefunded;
+    EscrowStatus status;     // Lifecycle state the flags are derived from
+    uint8 reserved1[3];      // Must be zero
+    uint32 depositTick;      // Tick the escrow was funded (signed in CosignedScoreMessage)
+    uint32 reserved2;        // Must be zero
+};
+
+static_assert(offsetof(StateResponse, brandId) == 0, "StateResponse layout changed");
+static_assert(offsetof(StateResponse, influencerId) == 32, "StateResponse layout changed");
+static_assert(offsetof(StateResponse, oracleId) == 64, "StateResponse layout changed");
+static_assert(offsetof(StateResponse, escrowBalance) == 96, "StateResponse layout changed");
+static_assert(offsetof(StateResponse, requiredScore) == 104, "StateResponse layout changed");
+static_assert(offsetof(StateResponse, verificationScore) == 105, "StateResponse layout changed");
+static_assert(offsetof(StateResponse, scoreSubmissions) == 106, "StateResponse layout changed");
+static_assert(offsetof(StateResponse, retentionEndTick) == 108, "StateResponse layout changed");
+static_assert(offsetof(StateResponse, isActive) == 112, "StateResponse layout changed");
+static_assert(offsetof(StateResponse, isVerified) == 113, "StateResponse layout changed");
+static_assert(offsetof(StateResponse, isPaid) == 114, "StateResponse layout changed");
+static_assert(offsetof(StateResponse, isRefunded) == 115, "StateResponse layout changed");
+static_assert(offsetof(StateResponse, status) == 116, "StateResponse layout changed");
+static_assert(offsetof(StateResponse, depositTick) == 120, "StateResponse layout changed");
+static_assert(sizeof(StateResponse) == 128, "StateResponse must stay padding-free");
+
+// getEscrowsPage party filter
+enum EscrowPartyFilter : uint8 {
+    ESCROW_PARTY_ANY = 0,
+    ESCROW_PARTY_BRAND = 1,      // key.brandId == party
+    ESCROW_PARTY_INFLUENCER = 2  // key.influencerId == party
+};
+
+// getEscrowsPage input
+struct EscrowPageInput {
+    id party;                // Brand or influencer for partyFilter
+    uint32 cursor;           // 0 to start, else nextCursor of the previous page
+    uint32 minSettleTick;    // Settlement window, inclusive; both 0 = no window
+    uint32 maxSettleTick;    // 0 = no upper bound
+    uint8 status;            // EscrowStatus to list, or ESCROW_STATUS_ANY
+    EscrowPartyFilter partyFilter;
+    uint8 reserved[2];       // Must be zero
+};
+
+static_assert(offsetof(EscrowPageInput, party) == 0, "EscrowPageInput layout changed");
+static_assert(offsetof(EscrowPageInput, cursor) == 32, "EscrowPageInput layout changed");
+static_assert(offsetof(EscrowPageInput, minSettleTick) == 36, "EscrowPageInput layout changed");
+static_assert(offsetof(EscrowPageInput, maxSettleTick) == 40, "EscrowPageInput layout changed");
+static_assert(offsetof(EscrowPageInput, status) == 44, "EscrowPageInput layout changed");
+static_assert(offsetof(EscrowPageInput, partyFilter) == 45, "EscrowPageInput layout changed");
+static_assert(sizeof(EscrowPageInput) == 48, "EscrowPageInput must stay padding-free");
+
+// One escrow in a getEscrowsPage response
+struct EscrowPageEntry {
+    EscrowKey key;
+    sint64 escrowBalance;
+    uint32 slot;             // Usable with setVerificationScoreBatch
+    uint32 retentionEndTick;
+    uint32 settleTick;       // 0 when not queued for settlement
+    EscrowStatus status;
+    uint8 requiredScore;
+    uint8 verificationScore;
+    uint8 reserved;          // Must be zero
+    uint32 depositTick;      // Pass back in ScoreBatchEntry
+    uint32 reserved2;        // Must be zero
+};
+
+static_assert(offsetof(EscrowPageEntry, key) == 0, "EscrowPageEntry layout changed");
+static_assert(offsetof(EscrowPageEntry, escrowBalance) == 72, "EscrowPageEntry layout changed");
+static_assert(offsetof(EscrowPageEntry, slot) == 80, "EscrowPageEntry layout changed");
+static_assert(offsetof(EscrowPageEntry, retentionEndTick) == 84, "EscrowPageEntry layout changed");
+static_assert(offsetof(EscrowPageEntry, settleTick) == 88, "EscrowPageEntry layout changed");
+static_assert(offsetof(EscrowPageEntry, status) == 92, "EscrowPageEntry layout changed");
+static_assert(offsetof(EscrowPageEntry, requiredScore) == 93, "EscrowPageEntry layout changed");
+static_assert(offsetof(EscrowPageEntry, verificationScore) == 94, "EscrowPageEntry layout changed");
+static_assert(offsetof(EscrowPageEntry, depositTick) == 96, "EscrowPageEntry layout changed");
+static_assert(sizeof(EscrowPageEntry) == 104, "EscrowPageEntry must stay padding-free");
+
+// getEscrowsPage output
+struct EscrowPageOutput {
+    uint32 count;            // Valid entries
+    uint32 nextCursor;       // Pass back to continue, 0 when done
+    EscrowPageEntry entries[ESCROW_PAGE_SIZE];
+};
+
+static_assert(offsetof(EscrowPageOutput, count) == 0, "EscrowPageOutput layout changed");
+static_assert(offsetof(EscrowPageOutput, nextCursor) == 4, "EscrowPageOutput layout changed");
+static_assert(offsetof(EscrowPageOutput, entries) == 8, "EscrowPageOutput layout changed");
+static_assert(sizeof(EscrowPageOutput) == 8 + ESCROW_PAGE_SIZE * sizeof(EscrowPageEntry), "EscrowPageOutput must stay padding-free");
+
+// Kind of a typed event in the contract's event ring
+enum EscrowEventKind : uint8 {
+    EVENT_NONE = 0,
+    EVENT_ORACLE_SET = 1,        // slot is INVALID (0xFFFFFFFF), amount = oracles, score = quorum
+    EVENT_DEPOSITED = 2,         // amount = deposit including fee
+    EVENT_VERIFIED = 3,          // score = verification score
+    EVENT_RELEASED = 4,          // amount = paid to influencer
+    EVENT_REFUNDED = 5,          // amount = returned to brand
+    EVENT_FEES_SWEPT = 6,        // slot is INVALID, amount = paid to the owner
+    EVENT_RECLAIMED = 7,         // final summary before the slot is freed: amount = settled,
+                                 // score = verification score, status = PAID or REFUNDED
+    EVENT_SCORE_SUBMITTED = 8,   // oracle score short of a decision: amount = oracle index,
+                                 // score = that oracle's score
+    EVENT_STREAM_CLAIMED = 9     // amount = accrual paid to the influencer; the stream's
+                                 // final payment is an EVENT_RELEASED
+};
+
+// One event in the ring; sequence numbers start at 1 and never repeat
+struct EscrowEvent {
+    uint64 sequence;
+    sint64 amount;
+    uint32 slot;
+    uint32 tick;             // Tick the event happened in
+    EscrowEventKind kind;
+    uint8 score;
+    EscrowStatus status;     // Escrow status when recorded (FREE for contract-level events)
+    uint8 reserved[5];       // Must be zero
+};
+
+static_assert(offsetof(EscrowEvent, sequence) == 0, "EscrowEvent layout changed");
+static_assert(offsetof(EscrowEvent, amount) == 8, "EscrowEvent layout changed");
+static_assert(offsetof(EscrowEvent, slot) == 16, "EscrowEvent layout changed");
+static_assert(offsetof(EscrowEvent, tick) == 20, "EscrowEvent layout changed");
+static_assert(offsetof(EscrowEvent, kind) == 24, "EscrowEvent layout changed");
+static_assert(offsetof(EscrowEvent, score) == 25, "EscrowEvent layout changed");
+static_assert(offsetof(EscrowEvent, status) == 26, "EscrowEvent layout changed");
+static_assert(sizeof(EscrowEvent) == 32, "EscrowEvent must stay padding-free");
+
+// getEventsSince input
+struct EventsInput {
+    uint64 afterSequence;    // Last sequence already seen, 0 for the oldest retained
+};
+
+static_assert(sizeof(EventsInput) == 8, "EventsInput layout changed");
+
+// getEventsSince output
+// If oldestSequence > afterSequence + 1 the caller missed events and must resync
+struct EventsOutput {
+    uint64 oldestSequence;   // Oldest event still in the ring (0 if none)
+    uint64 latestSequence;   // Newest event emitted (0 if none)
+    uint32 count;            // Valid events, in sequence order
+    uint32 reserved;         // Must be zero
+    EscrowEvent events[EVENT_PAGE_SIZE];
+};
+
+static_assert(offsetof(EventsOutput, oldestSequence) == 0, "EventsOutput layout changed");
+static_assert(offsetof(EventsOutput, latestSequence) == 8, "EventsOutput layout changed");
+static_assert(offsetof(EventsOutput, count) == 16, "EventsOutput layout changed");
+static_assert(offsetof(EventsOutput, events) == 24, "EventsOutput layout changed");
+static_assert(sizeof(EventsOutput) == 24 + EVENT_PAGE_SIZE * sizeof(EscrowEvent), "EventsOutput must stay padding-free");
+
+// getAggregates output (no input); running totals kept on every transition
+struct AggregatesOutput {
+    sint64 lockedBalance;    // Escrow balances of pending and verified escrows
+    sint64 lockedFees;       // Platform fees those escrows would earn on release
+    sint64 accruedFees;      // Earned fees awaiting the next sweep
+    sint64 sweptFees;        // Fees paid to the owner since deployment
+    sint64 totalDeposited;   // All deposits including fees, since deployment
+    sint64 totalReleased;    // Paid to influencers, since deployment
+    sint64 totalRefunded;    // Returned to brands, since deployment
+    uint32 pendingCount;
+    uint32 verifiedCount;
+    uint32 paidCount;        // Settled escrows not yet reclaimed
+    uint32 refundedCount;    // Settled escrows not yet reclaimed
+    uint32 availableSlots;   // Deposits the slot table can still take
+    uint32 queuedSettlements; // Escrows in the settlement queue
+};
+
+static_assert(offsetof(AggregatesOutput, lockedBalance) == 0, "AggregatesOutput layout changed");
+static_assert(offsetof(AggregatesOutput, totalRefunded) == 48, "AggregatesOutput layout changed");
+static_assert(offsetof(AggregatesOutput, pendingCount) == 56, "AggregatesOutput layout changed");
+static_assert(offsetof(AggregatesOutput, queuedSettlements) == 76, "AggregatesOutput layout changed");
+static_assert(sizeof(AggregatesOutput) == 80, "AggregatesOutput must stay padding-free");
+
+#endif // ESCROW_WIRE_H
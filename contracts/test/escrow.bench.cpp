@@ -0,0 +1,687 @@
+/*
+ * Qubic Smart Escrow Contract Microbenchmarks
+ * Drives every public procedure and function against the mock QPI
+ *
+ * Prints one JSON object; each benchmark is a single line so two runs
+ * diff line by line:
+ *   nsPerCall            best round's wall time per call (machine dependent)
+ *   instructionsPerCall  user-space instructions from the perf counter,
+ *                        null where perf events are unavailable
+ *   stateBytesWritten    bytes of contract state whose value one call changes
+ *   statePagesTouched    4 KiB state pages one call reads or writes
+ *                        (page-protection trace, Linux only, else null)
+ *
+ * Build and compare (from contracts/test):
+ *   g++ -std=c++17 -O2 -I. -o escrow_bench escrow.bench.cpp
+ *   ./escrow_bench > bench-before.json
+ *   ... change the contract ...
+ *   ./escrow_bench > bench-after.json && diff bench-before.json bench-after.json
+ *
+ * An optional argument runs only benchmarks whose name contains it.
+ *
+ * Benchmarks with a check fail the run (exit status 1) when a round did not
+ * do the work it is meant to time, e.g. every score was rejected.
+ */
+
+#include "qpi_test.h"
+#include "../src/escrow_wire.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <signal.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Contract under benchmark
+class EscrowContract : public QpiContractInstance {
+public:
+#include "../src/escrow.qpi"
+};
+
+static const char* BRAND_ID = "BRANDAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA";
+static const char* INFLUENCER_ID = "INFLURAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA";
+static const char* ORACLE_ID = "ORACLEAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA";
+
+static const uint32 ROUND_ESCROWS = 4096;    // Escrows a round works through
+static const uint32 DEPOSIT_BATCH = 16;      // Entries per depositFundsBatch call
+static const uint32 SCORE_BATCH = 64;        // Entries per setVerificationScoreBatch call
+static const uint32 COSIGNED_ESCROWS = MAX_COSIGNED_SCORES / MAX_ORACLES; // Escrows per submitCosignedScores call
+static const uint32 PAGE_SIZE_BYTES = 4096;  // Granularity of statePagesTouched
+
+// ============================================================================
+// INSTRUCTION COUNTER
+// ============================================================================
+
+/*
+ * User-space retired instructions of this thread, where perf allows it
+ */
+class InstructionCounter {
+public:
+    InstructionCounter() : fd(-1) {
+#ifdef __linux__
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+    }
+
+    ~InstructionCounter() {
+#ifdef __linux__
+        if (fd >= 0) {
+            close(fd);
+        }
+#endif
+    }
+
+    bool available() const {
+        return fd >= 0;
+    }
+
+    void reset() {
+#ifdef __linux__
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        }
+#endif
+    }
+
+    void start() {
+#ifdef __linux__
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    void stop() {
+#ifdef __linux__
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+#endif
+    }
+
+    uint64 read() const {
+        uint64 count = 0;
+#ifdef __linux__
+        if (fd >= 0 && ::read(fd, &count, sizeof(count)) != (ssize_t)sizeof(count)) {
+            count = 0;
+        }
+#endif
+        return count;
+    }
+
+private:
+    int fd;
+};
+
+// ============================================================================
+// STATE PAGE TRACE
+// ============================================================================
+
+#ifdef __linux__
+static uint8* traceBegin = nullptr;
+static uint8* traceEnd = nullptr;
+static uint8* traceTouched = nullptr;
+
+/*
+ * First touch of a protected page: record it and let the access proceed
+ */
+static void traceFault(int signo, siginfo_t* info, void* context) {
+    (void)context;
+    uint8* address = static_cast<uint8*>(info->si_addr);
+    if (address < traceBegin || address >= traceEnd) {
+        signal(signo, SIG_DFL);  // Genuine crash: re-fault with the default action
+        return;
+    }
+    size_t page = (size_t)(address - traceBegin) / PAGE_SIZE_BYTES;
+    traceTouched[page] = 1;
+    mprotect(traceBegin + page * PAGE_SIZE_BYTES, PAGE_SIZE_BYTES, PROT_READ | PROT_WRITE);
+}
+#endif
+
+/*
+ * Counts the state pages one call reads or writes
+ * The state must start on a page boundary and own every page it spans.
+ */
+class StatePageTrace {
+public:
+    StatePageTrace(void* state, size_t size)
+        : begin(static_cast<uint8*>(state)),
+          length((size + PAGE_SIZE_BYTES - 1) / PAGE_SIZE_BYTES * PAGE_SIZE_BYTES),
+          touched(length / PAGE_SIZE_BYTES) {
+#ifdef __linux__
+        struct sigaction action;
+        memset(&action, 0, sizeof(action));
+        action.sa_sigaction = traceFault;
+        action.sa_flags = SA_SIGINFO;
+        sigemptyset(&action.sa_mask);
+        sigaction(SIGSEGV, &action, nullptr);
+#endif
+    }
+
+    static bool available() {
+#ifdef __linux__
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void arm() {
+        memset(touched.data(), 0, touched.size());
+#ifdef __linux__
+        traceBegin = begin;
+        traceEnd = begin + length;
+        traceTouched = touched.data();
+        mprotect(begin, length, PROT_NONE);
+#endif
+    }
+
+    uint32 disarm() {
+#ifdef __linux__
+        mprotect(begin, length, PROT_READ | PROT_WRITE);
+        traceBegin = traceEnd = nullptr;
+#endif
+        uint32 pages = 0;
+        for (uint8 page : touched) {
+            pages += page;
+        }
+        return pages;
+    }
+
+private:
+    uint8* begin;
+    size_t length;
+    std::vector<uint8> touched;
+};
+
+// ============================================================================
+// BENCH CONTRACT
+// ============================================================================
+
+// Driver data, kept in a base ahead of the contract so state is the last thing in the object
+struct BenchInputs {
+    id brand;
+    id influencers[DEPOSIT_BATCH];
+    id oracle;
+    id oracles[MAX_ORACLES];
+    std::vector<CosignedScoreEntry> cosigned;  // Pre-signed, MAX_ORACLES per escrow in slot order
+    uint32 pageCursor;
+};
+
+class BenchContract : public BenchInputs, public EscrowContract {
+public:
+    typedef void (BenchContract::*Step)(uint32 call);
+    typedef void (BenchContract::*Setup)();
+    typedef bool (BenchContract::*Check)() const;
+
+    // ------------------------------------------------------------------
+    // Setup (untimed)
+    // ------------------------------------------------------------------
+
+    void resetContract(bool fullOracleSet = false) {
+        initialize();
+        mockCurrentTick = 100000;
+        mockContractBalance = 0;
+        pageCursor = 0;
+
+        brand = qpiTestId(BRAND_ID);
+        oracle = qpiTestId(ORACLE_ID);
+        for (uint32 i = 0; i < DEPOSIT_BATCH; i++) {
+            char identity[61];
+            memset(identity, 'A', 60);
+            identity[60] = 0;
+            memcpy(identity, INFLUENCER_ID, 6);
+            identity[6] = (char)('A' + i);
+            stringToId(identity, &influencers[i]);
+        }
+        for (uint32 i = 0; i < MAX_ORACLES; i++) {
+            char identity[61];
+            memset(identity, 'A', 60);
+            identity[60] = 0;
+            memcpy(identity, ORACLE_ID, 6);
+            identity[6] = (char)('A' + i);
+            stringToId(identity, &oracles[i]);
+        }
+
+        if (fullOracleSet) {
+            // Every oracle must score: the most work per decision
+            OracleSetInput input;
+            memset(&input, 0, sizeof(input));
+            memcpy(input.oracles, oracles, sizeof(oracles));
+            input.count = MAX_ORACLES;
+            input.quorum = MAX_ORACLES;
+            input.aggregation = SCORE_AGGREGATION_MEDIAN;
+            id ownerId;
+            qpi.getContractOwner(&ownerId);
+            mockSetCaller(ownerId);
+            CALL_PROCEDURE(setOracleSet, &input, sizeof(input));
+        }
+
+        mockSetCaller(BRAND_ID);
+        mockSetBalance(BRAND_ID, 1000000000000LL);
+        CALL_PROCEDURE(setOracleId, &oracle, sizeof(id));
+    }
+
+    void populatePending() {
+        resetContract();
+        for (uint32 i = 0; i < ROUND_ESCROWS; i++) {
+            deposit(i);
+        }
+    }
+
+    void populateVerified(uint8 value) {
+        populatePending();
+        mockSetCaller(ORACLE_ID);
+        for (uint32 i = 0; i < ROUND_ESCROWS; i++) {
+            score(i, value);
+        }
+    }
+
+    void setupEmpty() {
+        resetContract();
+    }
+
+    void setupUnsetOracle() {
+        initialize();
+        mockCurrentTick = 100000;
+        mockSetCaller(BRAND_ID);
+    }
+
+    void setupPending() {
+        populatePending();
+    }
+
+    void setupPendingForOracle() {
+        populatePending();
+        mockSetCaller(ORACLE_ID);
+    }
+
+    void setupPassing() {
+        populateVerified(96);
+        mockCurrentTick = state.escrows[0].retentionEndTick;
+        mockSetCaller(ORACLE_ID);
+    }
+
+    void setupFailingUnsettled() {
+        populateVerified(10);
+    }
+
+    void setupCosigned() {
+        resetContract(true);
+        for (uint32 i = 0; i < ROUND_ESCROWS; i++) {
+            deposit(i);
+        }
+
+        cosigned.clear();
+        for (uint32 slot = 0; slot < ROUND_ESCROWS; slot++) {
+            CosignedScoreMessage message;
+            memset(&message, 0, sizeof(message));
+            message.key = state.escrows[slot].key;
+            message.slot = slot;
+            message.depositTick = state.escrows[slot].depositTick;
+            for (uint32 i = 0; i < MAX_ORACLES; i++) {
+                message.score = (uint8)(90 + i);
+                id digest;
+                qpiTestDigest(&message, sizeof(message), &digest);
+
+                CosignedScoreEntry entry;
+                memset(&entry, 0, sizeof(entry));
+                entry.slot = slot;
+                entry.score = message.score;
+                entry.oracleIndex = (uint8)i;
+                qpiTestSign(oracles[i], digest, entry.signature);
+                cosigned.push_back(entry);
+            }
+        }
+        mockSetCaller(BRAND_ID);
+    }
+
+    // ------------------------------------------------------------------
+    // Checks (untimed, after each round)
+    // ------------------------------------------------------------------
+
+    bool checkAllVerified() const {
+        return state.statusCount[ESCROW_VERIFIED] == ROUND_ESCROWS;
+    }
+
+    // ------------------------------------------------------------------
+    // Steps (timed)
+    // ------------------------------------------------------------------
+
+    void stepSetOracleId(uint32 call) {
+        (void)call;
+        CALL_PROCEDURE(setOracleId, &oracle, sizeof(id));
+    }
+
+    void stepDepositFunds(uint32 call) {
+        deposit(call);
+    }
+
+    void stepDepositFundsBatch(uint32 call) {
+        struct {
+            DepositBatchHeader header;
+            DepositBatchEntry entries[DEPOSIT_BATCH];
+        } input;
+        memset(&input, 0, sizeof(input));
+        input.header.count = DEPOSIT_BATCH;
+        input.header.campaignNonce = call;
+        for (uint32 i = 0; i < DEPOSIT_BATCH; i++) {
+            input.entries[i].influencerId = influencers[i];
+            input.entries[i].amount = 100000;
+            input.entries[i].retentionDays = 7;
+            input.header.totalAmount += 100000;
+        }
+
+        DepositBatchOutput output;
+        CALL_PROCEDURE_OUT(depositFundsBatch, &input, sizeof(input), &output, sizeof(output));
+    }
+
+    void stepSetVerificationScore(uint32 call) {
+        score(call, 96);
+    }
+
+    void stepSetVerificationScoreBatch(uint32 call) {
+        struct {
+            uint32 count;
+            ScoreBatchEntry entries[SCORE_BATCH];
+        } input;
+        memset(&input, 0, sizeof(input));
+        input.count = SCORE_BATCH;
+        for (uint32 i = 0; i < SCORE_BATCH; i++) {
+            input.entries[i].slot = call * SCORE_BATCH + i;
+            input.entries[i].depositTick = state.escrows[input.entries[i].slot].depositTick;
+            input.entries[i].score = 96;
+        }
+
+        ScoreBatchOutput output;
+        CALL_PROCEDURE_OUT(setVerificationScoreBatch, &input, sizeof(input), &output, sizeof(output));
+    }
+
+    void stepSubmitCosignedScores(uint32 call) {
+        struct {
+            uint32 count;
+            CosignedScoreEntry entries[MAX_COSIGNED_SCORES];
+        } input;
+        input.count = MAX_COSIGNED_SCORES;
+        memcpy(input.entries, &cosigned[call * MAX_COSIGNED_SCORES], sizeof(input.entries));
+
+        ScoreBatchOutput output;
+        CALL_PROCEDURE_OUT(submitCosignedScores, &input, sizeof(input), &output, sizeof(output));
+    }
+
+    void stepReleasePayment(uint32 call) {
+        EscrowKey key = keyFor(call);
+        CALL_PROCEDURE(releasePayment, &key, sizeof(EscrowKey));
+    }
+
+    void stepRefundFunds(uint32 call) {
+        EscrowKey key = keyFor(call);
+        CALL_PROCEDURE(refundFunds, &key, sizeof(EscrowKey));
+    }
+
+    void stepEndTick(uint32 call) {
+        (void)call;
+        CALL_END_TICK();
+    }
+
+    void stepGetContractState(uint32 call) {
+        EscrowKey key = keyFor(call % ROUND_ESCROWS);
+        StateResponse output;
+        CALL_FUNCTION_WITH_INPUT(getContractState, &key, sizeof(EscrowKey), &output, sizeof(output));
+    }
+
+    void stepGetEscrowsPage(uint32 call) {
+        (void)call;
+        EscrowPageInput input;
+        memset(&input, 0, sizeof(input));
+        input.status = ESCROW_PENDING;
+        input.cursor = pageCursor;
+
+        EscrowPageOutput output;
+        CALL_FUNCTION_WITH_INPUT(getEscrowsPage, &input, sizeof(input), &output, sizeof(output));
+        pageCursor = output.nextCursor;
+    }
+
+    void stepGetEventsSince(uint32 call) {
+        EventsInput input;
+        input.afterSequence = (uint64)(call * EVENT_PAGE_SIZE) % (ROUND_ESCROWS - EVENT_PAGE_SIZE);
+
+        EventsOutput output;
+        CALL_FUNCTION_WITH_INPUT(getEventsSince, &input, sizeof(input), &output, sizeof(output));
+    }
+
+    void stepGetAggregates(uint32 call) {
+        (void)call;
+        AggregatesOutput output;
+        CALL_FUNCTION(getAggregates, &output, sizeof(output));
+    }
+
+private:
+    EscrowKey keyFor(uint32 nonce) const {
+        EscrowKey key;
+        key.brandId = brand;
+        key.influencerId = influencers[0];
+        key.campaignNonce = nonce;
+        return key;
+    }
+
+    void deposit(uint32 nonce) {
+        DepositInput input = {};
+        input.amount = 100000;
+        input.influencerId = influencers[0];
+        input.retentionDays = 7;
+        input.campaignNonce = nonce;
+
+        DepositOutput output;
+        CALL_PROCEDURE_OUT(depositFunds, &input, sizeof(DepositInput), &output, sizeof(DepositOutput));
+    }
+
+    void score(uint32 nonce, uint8 value) {
+        ScoreInput input;
+        memset(&input, 0, sizeof(input));
+        input.key = keyFor(nonce);
+        input.score = value;
+        CALL_PROCEDURE(setVerificationScore, &input, sizeof(ScoreInput));
+    }
+};
+
+/*
+ * Allocate a BenchContract whose state starts on a page boundary
+ */
+class AlignedBenchContract {
+public:
+    AlignedBenchContract() {
+        size_t offset = stateOffset();
+        size_t total = sizeof(BenchContract) + 2 * PAGE_SIZE_BYTES;
+        raw = static_cast<uint8*>(aligned_alloc(PAGE_SIZE_BYTES, (total + PAGE_SIZE_BYTES - 1) / PAGE_SIZE_BYTES * PAGE_SIZE_BYTES));
+        size_t shift = (PAGE_SIZE_BYTES - offset % PAGE_SIZE_BYTES) % PAGE_SIZE_BYTES;
+        contract = new (raw + shift) BenchContract();
+    }
+
+    ~AlignedBenchContract() {
+        contract->~BenchContract();
+        free(raw);
+    }
+
+    BenchContract* operator->() const {
+        return contract;
+    }
+
+    BenchContract& operator*() const {
+        return *contract;
+    }
+
+private:
+    static size_t stateOffset() {
+        std::unique_ptr<BenchContract> probe(new BenchContract());
+        return (size_t)(reinterpret_cast<uint8*>(&probe->state) - reinterpret_cast<uint8*>(probe.get()));
+    }
+
+    uint8* raw;
+    BenchContract* contract;
+};
+
+// ============================================================================
+// BENCHMARKS
+// ============================================================================
+
+struct Benchmark {
+    const char* name;
+    BenchContract::Setup setup;   // Brings the contract to the start of a round
+    BenchContract::Step step;     // One timed call
+    uint32 callsPerRound;
+    uint32 rounds;
+    uint32 itemsPerCall;          // Escrows handled by one call
+    BenchContract::Check check;   // Round did the work it times (nullptr: not checked)
+};
+
+static const Benchmark benchmarks[] = {
+    { "setOracleId", &BenchContract::setupUnsetOracle, &BenchContract::stepSetOracleId, 1, 256, 1 },
+    { "depositFunds", &BenchContract::setupEmpty, &BenchContract::stepDepositFunds, ROUND_ESCROWS, 16, 1 },
+    { "depositFundsBatch", &BenchContract::setupEmpty, &BenchContract::stepDepositFundsBatch,
+      ROUND_ESCROWS / DEPOSIT_BATCH, 16, DEPOSIT_BATCH },
+    { "setVerificationScore", &BenchContract::setupPendingForOracle, &BenchContract::stepSetVerificationScore, ROUND_ESCROWS, 16, 1 },
+    { "setVerificationScoreBatch", &BenchContract::setupPendingForOracle, &BenchContract::stepSetVerificationScoreBatch,
+      ROUND_ESCROWS / SCORE_BATCH, 16, SCORE_BATCH, &BenchContract::checkAllVerified },
+    { "submitCosignedScores", &BenchContract::setupCosigned, &BenchContract::stepSubmitCosignedScores,
+      ROUND_ESCROWS / COSIGNED_ESCROWS, 16, COSIGNED_ESCROWS, &BenchContract::checkAllVerified },
+    { "releasePayment", &BenchContract::setupPassing, &BenchContract::stepReleasePayment, ROUND_ESCROWS, 16, 1 },
+    { "refundFunds", &BenchContract::setupFailingUnsettled, &BenchContract::stepRefundFunds, ROUND_ESCROWS, 16, 1 },
+    { "endTick.settle", &BenchContract::setupPassing, &BenchContract::stepEndTick,
+      ROUND_ESCROWS / EscrowContract::MAX_AUTO_SETTLEMENTS_PER_TICK, 16, EscrowContract::MAX_AUTO_SETTLEMENTS_PER_TICK },
+    { "endTick.idle", &BenchContract::setupPending, &BenchContract::stepEndTick, ROUND_ESCROWS, 16, 0 },
+    { "getContractState", &BenchContract::setupPending, &BenchContract::stepGetContractState, ROUND_ESCROWS, 16, 1 },
+    { "getEscrowsPage", &BenchContract::setupPending, &BenchContract::stepGetEscrowsPage,
+      ROUND_ESCROWS / ESCROW_PAGE_SIZE, 16, ESCROW_PAGE_SIZE },
+    { "getEventsSince", &BenchContract::setupPending, &BenchContract::stepGetEventsSince, ROUND_ESCROWS, 16, EVENT_PAGE_SIZE },
+    { "getAggregates", &BenchContract::setupPending, &BenchContract::stepGetAggregates, ROUND_ESCROWS, 16, 0 },
+};
+
+struct BenchResult {
+    uint64 calls;
+    double nsPerCall;
+    double instructionsPerCall;
+    uint64 stateBytesWritten;
+    uint32 statePagesTouched;
+    bool checkFailed;             // A round failed the benchmark's check
+};
+
+/*
+ * Time every round, then trace one call from the middle of a fresh round
+ */
+static BenchResult runBenchmark(BenchContract& contract, const Benchmark& benchmark,
+                                InstructionCounter& counter, StatePageTrace& trace,
+                                std::vector<uint8>& snapshot) {
+    BenchResult result;
+    memset(&result, 0, sizeof(result));
+    result.nsPerCall = -1;
+
+    counter.reset();
+    for (uint32 round = 0; round < benchmark.rounds; round++) {
+        (contract.*benchmark.setup)();
+
+        counter.start();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (uint32 call = 0; call < benchmark.callsPerRound; call++) {
+            (contract.*benchmark.step)(call);
+        }
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        counter.stop();
+
+        if (benchmark.check != nullptr && !(contract.*benchmark.check)()) {
+            result.checkFailed = true;
+        }
+
+        double ns = std::chrono::duration<double, std::nano>(end - start).count() / benchmark.callsPerRound;
+        if (result.nsPerCall < 0 || ns < result.nsPerCall) {
+            result.nsPerCall = ns;
+        }
+        result.calls += benchmark.callsPerRound;
+    }
+    result.instructionsPerCall = (double)counter.read() / (double)result.calls;
+
+    // State footprint of one representative call
+    (contract.*benchmark.setup)();
+    uint32 middle = benchmark.callsPerRound / 2;
+    for (uint32 call = 0; call < middle; call++) {
+        (contract.*benchmark.step)(call);
+    }
+
+    memcpy(snapshot.data(), &contract.state, sizeof(contract.state));
+    trace.arm();
+    (contract.*benchmark.step)(middle);
+    result.statePagesTouched = trace.disarm();
+
+    const uint8* after = reinterpret_cast<const uint8*>(&contract.state);
+    for (size_t i = 0; i < snapshot.size(); i++) {
+        result.stateBytesWritten += snapshot[i] != after[i];
+    }
+    return result;
+}
+
+int main(int argc, char** argv) {
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+
+    AlignedBenchContract contract;
+    InstructionCounter counter;
+    StatePageTrace trace(&contract->state, sizeof(contract->state));
+    std::vector<uint8> snapshot(sizeof(contract->state));
+
+    printf("{\n");
+    printf("  \"contract\": \"escrow.qpi\",\n");
+    printf("  \"stateBytes\": %zu,\n", sizeof(contract->state));
+    printf("  \"recordBytes\": %zu,\n", sizeof(EscrowContract::ESCROW_RECORD));
+    printf("  \"instructionCounter\": %s,\n", counter.available() ? "true" : "false");
+    printf("  \"benchmarks\": [\n");
+
+    bool first = true;
+    bool failed = false;
+    for (const Benchmark& benchmark : benchmarks) {
+        if (filter != nullptr && strstr(benchmark.name, filter) == nullptr) {
+            continue;
+        }
+
+        BenchResult result = runBenchmark(*contract, benchmark, counter, trace, snapshot);
+
+        char instructions[32];
+        char pages[32];
+        if (counter.available()) {
+            snprintf(instructions, sizeof(instructions), "%.0f", result.instructionsPerCall);
+        } else {
+            snprintf(instructions, sizeof(instructions), "null");
+        }
+        if (StatePageTrace::available()) {
+            snprintf(pages, sizeof(pages), "%u", result.statePagesTouched);
+        } else {
+            snprintf(pages, sizeof(pages), "null");
+        }
+
+        printf("%s    {\"name\": \"%s\", \"itemsPerCall\": %u, \"calls\": %llu, \"nsPerCall\": %.1f, "
+               "\"instructionsPerCall\": %s, \"stateBytesWritten\": %llu, \"statePagesTouched\": %s}",
+               first ? "" : ",\n", benchmark.name, benchmark.itemsPerCall,
+               (unsigned long long)result.calls, result.nsPerCall, instructions,
+               (unsigned long long)result.stateBytesWritten, pages);
+        first = false;
+        
+        if (result.checkFailed) {
+            fprintf(stderr, "%s: a round did not do the work it times; its figures are not a valid baseline\n",
+                    benchmark.name);
+            failed = true;
+        }
+    }
+
+    printf("\n  ]\n");
+    printf("}\n");
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,106 @@
+/*
+ * Qubic Smart Escrow Contract Trace Replay
+ * Replays a recorded call trace against this build of escrow.qpi
+ *
+ * Every record is applied to a freshly constructed contract with the
+ * recorded caller, tick, epoch and contract balance; after each one the
+ * state hash (and the output hash of calls) is compared with the recording.
+ * The first mismatch is reported and the replay stops there.
+ *
+ * Record a trace with the simulator (./escrow_sim ... trace=day.trace) or
+ * from a test: open a QpiTraceRecorder on &state and attach it with
+ * mockStartRecording().
+ *
+ * Build and run (from contracts/test):
+ *   g++ -std=c++17 -O2 -I. -o escrow_replay escrow.replay.cpp
+ *   ./escrow_replay day.trace
+ *
+ * --compare finds changed state by comparing against a shadow copy instead
+ * of write-protecting the state (slower, but no signal handler).
+ *
+ * Exit status: 0 replay matches, 1 diverged, 2 unusable trace.
+ */
+
+#include "qpi_test.h"
+#include "../src/escrow_wire.h"
+
+// Contract under replay
+class EscrowContract : public QpiContractInstance {
+public:
+#include "../src/escrow.qpi"
+};
+
+#include "escrow_entry_points.h"
+
+static const char* kindName(uint8 kind) {
+    switch (kind) {
+    case QPI_TRACE_NAME: return "name";
+    case QPI_TRACE_CALL: return "call";
+    case QPI_TRACE_END_TICK: return "END_TICK";
+    case QPI_TRACE_END_EPOCH: return "END_EPOCH";
+    case QPI_TRACE_SET_BALANCE: return "setBalance";
+    case QPI_TRACE_SET_OWNER: return "setOwner";
+    default: return "unknown";
+    }
+}
+
+int main(int argc, char** argv) {
+    const char* path = nullptr;
+    bool trapWrites = true;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--compare") == 0) {
+            trapWrites = false;
+        } else {
+            path = argv[i];
+        }
+    }
+    if (path == nullptr) {
+        fprintf(stderr, "usage: escrow_replay [--compare] <trace>\n");
+        return 2;
+    }
+
+    QpiTraceReader trace;
+    std::string error;
+    if (!trace.open(path, error)) {
+        fprintf(stderr, "escrow_replay: %s: %s\n", path, error.c_str());
+        return 2;
+    }
+
+    uint64 calls = 0;
+    uint64 ticks = 0;
+    for (size_t i = 0; i < trace.records(); i++) {
+        calls += trace.record(i).kind == QPI_TRACE_CALL;
+        ticks += trace.record(i).kind == QPI_TRACE_END_TICK;
+    }
+
+    std::unique_ptr<EscrowContract> contract(new EscrowContract());
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    QpiReplayResult result = escrowReplayer().replay(*contract, trace, trapWrites);
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    printf("%s: %zu records (%llu calls, %llu ticks), %llu replayed in %.1f ms (%.0f records/s)\n",
+           path, trace.records(), (unsigned long long)calls, (unsigned long long)ticks,
+           (unsigned long long)result.records, elapsedMs,
+           elapsedMs > 0 ? result.records * 1000.0 / elapsedMs : 0.0);
+
+    if (!result.diverged) {
+        printf("state hashes match\n");
+        return 0;
+    }
+
+    if (result.records == 0) {
+        printf("DIVERGED before the first record: %s\n", result.reason.c_str());
+    } else {
+        const QpiTraceRecord& record = trace.record(result.divergedAt);
+        printf("DIVERGED at record %llu (%s%s%s, tick %u, epoch %u): %s\n",
+               (unsigned long long)result.divergedAt, kindName(record.kind),
+               record.kind == QPI_TRACE_CALL ? " " : "",
+               record.kind == QPI_TRACE_CALL ? trace.name(record.name).c_str() : "",
+               record.tick, record.epoch, result.reason.c_str());
+    }
+    if (result.expectedHash != result.actualHash) {
+        printf("  recorded 0x%016llx, this build 0x%016llx\n",
+               (unsigned long long)result.expectedHash, (unsigned long long)result.actualHash);
+    }
+    return 1;
+}
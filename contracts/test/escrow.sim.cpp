@@ -0,0 +1,836 @@
+/*
+ * Qubic Smart Escrow Contract Tick Simulator
+ * Deterministic load generator driving escrow.qpi through the mock QPI
+ *
+ * Every simulated tick makes `calls` contract calls drawn from a weighted
+ * mix (deposits, batch deposits, scores, batch scores, early releases,
+ * refunds, queries) across up to `escrows` concurrent escrows, runs
+ * END_TICK and then reads the new events back through getEventsSince to
+ * learn which escrows settled or were reclaimed - the same way the oracle
+ * agent follows the contract. Funds move through the mock ledger only.
+ *
+ * All inputs come from one seeded generator, so a configuration always
+ * makes the same calls and ends in the same state; only the wall-clock
+ * fields (wallMs, callsPerSecond, endTickNs*) vary between runs.
+ *
+ * Prints one JSON object: the configuration, one sample per `sample` ticks
+ * (a single line each) and a summary with throughput and consistency
+ * checks. Sample fields:
+ *   calls, deposited, rejected    calls made, escrows opened, deposits the
+ *                                 contract refused (table full)
+ *   released, refunded            settlements by call and by END_TICK
+ *   autoSettled, maxAutoSettled   END_TICK settlements, total and worst tick
+ *   reclaimed                     slots returned to the free-list
+ *   endTickNsMean, endTickNsMax   END_TICK wall time per tick
+ *   active, queued, highWater     escrows holding funds, settlement heap
+ *                                 size, slots ever used
+ *   indexLoad, ledgerAccounts     index occupancy, mock ledger size
+ *
+ * Build and run (from contracts/test):
+ *   g++ -std=c++17 -O2 -I. -o escrow_sim escrow.sim.cpp
+ *   ./escrow_sim escrows=16384 ticks=250000 seed=7
+ *
+ * Options, as key=value (defaults in brackets):
+ *   escrows [4096]    concurrent escrow target; deposits pause at it. Above
+ *                     MAX_ESCROWS the contract refuses the excess, which
+ *                     shows up as `rejected`
+ *   ticks [250000]    ticks to simulate (retention plus reclaim grace is
+ *                     201600 ticks, so the default covers a full lifecycle)
+ *   calls [4]         contract calls per tick
+ *   seed [1]          generator seed
+ *   deposit, depositBatch, score, scoreBatch, release, refund, query
+ *                     call mix weights [30, 10, 30, 10, 5, 5, 10]
+ *   batch [16]        entries per batch call
+ *   pass [80]         percent of scores at or above the required score
+ *   retention [7]     retention days per deposit
+ *   brands [64], influencers [1024]   distinct parties
+ *   sample [10000]    ticks per sample line
+ *   trace [none]      record every call to this file for escrow_replay
+ */
+
+#include "qpi_test.h"
+#include "../src/escrow_wire.h"
+
+#include <queue>
+
+// Contract under simulation
+class EscrowContract : public QpiContractInstance {
+public:
+#include "../src/escrow.qpi"
+};
+
+static const char* OWNER_ID = "OWNERAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA";
+static const char* ORACLE_ID = "ORACLEAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA";
+
+static const uint32 START_TICK = 100000;
+static const sint64 BRAND_FUNDS = 1000000000000000LL;
+static const sint64 MIN_DEPOSIT = 10000;
+static const sint64 MAX_DEPOSIT = 10000000;
+static const uint32 NOT_LISTED = 0xFFFFFFFF;
+
+// Worst-case events a tick can emit besides its calls: settlements, reclaims, sweep
+static const uint32 END_TICK_EVENTS = 64 + 64 + 1;
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+enum SimOp {
+    OP_DEPOSIT,
+    OP_DEPOSIT_BATCH,
+    OP_SCORE,
+    OP_SCORE_BATCH,
+    OP_RELEASE,
+    OP_REFUND,
+    OP_QUERY,
+    OP_COUNT
+};
+
+static const char* const OP_NAMES[OP_COUNT] = {
+    "deposit", "depositBatch", "score", "scoreBatch", "release", "refund", "query"
+};
+
+struct SimConfig {
+    uint32 escrows;
+    uint32 ticks;
+    uint32 calls;
+    uint64 seed;
+    uint32 weights[OP_COUNT];
+    uint32 batch;
+    uint32 passPercent;
+    uint32 retentionDays;
+    uint32 brands;
+    uint32 influencers;
+    uint32 sampleTicks;
+    const char* tracePath;       // nullptr: no recording
+};
+
+static SimConfig defaultConfig() {
+    SimConfig config;
+    config.escrows = 4096;
+    config.ticks = 250000;
+    config.calls = 4;
+    config.seed = 1;
+    const uint32 weights[OP_COUNT] = { 30, 10, 30, 10, 5, 5, 10 };
+    memcpy(config.weights, weights, sizeof(weights));
+    config.batch = 16;
+    config.passPercent = 80;
+    config.retentionDays = 7;
+    config.brands = 64;
+    config.influencers = 1024;
+    config.sampleTicks = 10000;
+    config.tracePath = nullptr;
+    return config;
+}
+
+/*
+ * Apply one key=value option
+ * Returns false for an unknown key or a malformed value
+ */
+static bool parseOption(SimConfig& config, const char* option) {
+    const char* equals = strchr(option, '=');
+    if (equals == nullptr || equals[1] == 0) {
+        return false;
+    }
+    std::string key(option, equals - option);
+    if (key == "trace") {
+        config.tracePath = equals + 1;
+        return true;
+    }
+
+    char* end = nullptr;
+    unsigned long long value = strtoull(equals + 1, &end, 10);
+    if (*end != 0) {
+        return false;
+    }
+
+    for (uint32 op = 0; op < OP_COUNT; op++) {
+        if (key == OP_NAMES[op]) {
+            config.weights[op] = (uint32)value;
+            return true;
+        }
+    }
+
+    if (key == "escrows") config.escrows = (uint32)value;
+    else if (key == "ticks") config.ticks = (uint32)value;
+    else if (key == "calls") config.calls = (uint32)value;
+    else if (key == "seed") config.seed = value;
+    else if (key == "batch") config.batch = (uint32)value;
+    else if (key == "pass") config.passPercent = (uint32)value;
+    else if (key == "retention") config.retentionDays = (uint32)value;
+    else if (key == "brands") config.brands = (uint32)value;
+    else if (key == "influencers") config.influencers = (uint32)value;
+    else if (key == "sample") config.sampleTicks = (uint32)value;
+    else return false;
+    return true;
+}
+
+/*
+ * Reject configurations the generator cannot drive faithfully
+ * Returns an error message, or nullptr if the configuration is usable
+ */
+static const char* validateConfig(const SimConfig& config) {
+    uint32 totalWeight = 0;
+    for (uint32 op = 0; op < OP_COUNT; op++) {
+        totalWeight += config.weights[op];
+    }
+    if (config.escrows == 0 || config.escrows > 1000000) return "escrows must be 1..1000000";
+    if (config.ticks == 0) return "ticks must be positive";
+    if (totalWeight == 0 && config.calls > 0) return "call mix weights are all zero";
+    if (config.batch == 0 || config.batch > MAX_DEPOSIT_BATCH || config.batch > MAX_SCORE_BATCH) return "batch must be 1..200";
+    if (config.batch > config.influencers) return "batch must not exceed influencers";
+    if (config.passPercent > 100) return "pass must be 0..100";
+    if (config.retentionDays > EscrowContract::MAX_RETENTION_DAYS) return "retention must be at most 365 days";
+    if (config.retentionDays * EscrowContract::TICKS_PER_DAY < EscrowContract::MIN_RETENTION_TICKS) return "retention must be at least 7 days";
+    if (config.brands == 0 || config.influencers == 0) return "brands and influencers must be positive";
+    if (config.sampleTicks == 0) return "sample must be positive";
+
+    // Events are read back once after the calls and once after END_TICK
+    if ((uint64)config.calls * config.batch > EscrowContract::EVENT_RING_SIZE || END_TICK_EVENTS > EscrowContract::EVENT_RING_SIZE) {
+        return "calls x batch would overrun the event ring between reads";
+    }
+    return nullptr;
+}
+
+// ============================================================================
+// GENERATOR
+// ============================================================================
+
+/*
+ * SplitMix64: small, fast and identical on every platform
+ */
+class SimRandom {
+public:
+    explicit SimRandom(uint64 seed) : value(seed) {}
+
+    uint64 next() {
+        uint64 z = (value += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform in [0, bound), bound > 0
+    uint32 below(uint32 bound) {
+        return (uint32)(next() % bound);
+    }
+
+private:
+    uint64 value;
+};
+
+// ============================================================================
+// SIMULATOR
+// ============================================================================
+
+// Generator's view of a slot, kept in step with the contract through events
+enum SimPhase : uint8 {
+    SIM_FREE,
+    SIM_PENDING,       // Deposited, waiting for a score
+    SIM_PASSING,       // Scored at or above the required score
+    SIM_FAILING,       // Scored below it, refunded at the next END_TICK at the latest
+    SIM_SETTLED        // Paid or refunded, slot not yet reclaimed
+};
+
+struct SimEscrow {
+    uint64 nonce;
+    uint32 brand;
+    uint32 influencer;
+    uint32 retentionEndTick;
+    uint32 listPos;    // Position in the pending or failing list, NOT_LISTED otherwise
+    SimPhase phase;
+};
+
+// Counters for one sample window
+struct SimWindow {
+    uint64 calls;
+    uint64 deposited;
+    uint64 rejected;
+    uint64 released;
+    uint64 refunded;
+    uint64 autoSettled;
+    uint64 reclaimed;
+    uint32 maxAutoSettled;
+    double endTickNsTotal;
+    double endTickNsMax;
+    uint32 ticks;
+};
+
+class TickSimulator : public EscrowContract {
+public:
+    explicit TickSimulator(const SimConfig& simConfig)
+        : config(simConfig),
+          random(simConfig.seed),
+          escrows(MAX_ESCROWS),
+          activeCount(0),
+          nonceCounter(0),
+          lastSequence(0),
+          missedEvents(0),
+          modelErrors(0) {
+        memset(&window, 0, sizeof(window));
+        memset(&totals, 0, sizeof(totals));
+        totalWeight = 0;
+        for (uint32 op = 0; op < OP_COUNT; op++) {
+            totalWeight += config.weights[op];
+        }
+
+        brandIds.resize(config.brands);
+        for (uint32 i = 0; i < config.brands; i++) {
+            brandIds[i] = partyId(1, i);
+        }
+        influencerIds.resize(config.influencers);
+        for (uint32 i = 0; i < config.influencers; i++) {
+            influencerIds[i] = partyId(2, i);
+        }
+    }
+
+    int run() {
+        initialize();
+        mockCurrentTick = START_TICK;
+        if (config.tracePath != nullptr) {
+            // Single-threaded, so the hash can trap writes instead of diffing the state
+            if (!recorder.open(config.tracePath, &state, sizeof(state), true)) {
+                fprintf(stderr, "escrow_sim: cannot write %s\n", config.tracePath);
+                return 2;
+            }
+            mockStartRecording(&recorder);
+        }
+        for (const id& brand : brandIds) {
+            mockSetBalance(brand, BRAND_FUNDS);
+        }
+
+        id oracle = qpiTestId(ORACLE_ID);
+        mockSetCaller(OWNER_ID);
+        CALL_PROCEDURE(setOracleId, &oracle, sizeof(id));
+        drainEvents(false);
+
+        printf("{\n");
+        printf("  \"contract\": \"escrow.qpi\",\n");
+        printConfig();
+        printf("  \"samples\": [\n");
+
+        std::chrono::steady_clock::time_point runStart = std::chrono::steady_clock::now();
+        for (uint32 tick = 0; tick < config.ticks; tick++) {
+            for (uint32 call = 0; call < config.calls; call++) {
+                performCall(pickOp());
+            }
+            drainEvents(false);
+
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            CALL_END_TICK();
+            double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            window.endTickNsTotal += ns;
+            if (ns > window.endTickNsMax) {
+                window.endTickNsMax = ns;
+            }
+
+            uint64 settledBefore = window.autoSettled;
+            drainEvents(true);
+            uint32 settledThisTick = (uint32)(window.autoSettled - settledBefore);
+            if (settledThisTick > window.maxAutoSettled) {
+                window.maxAutoSettled = settledThisTick;
+            }
+            window.ticks++;
+
+            if ((tick + 1) % config.sampleTicks == 0 || tick + 1 == config.ticks) {
+                printSample(tick + 1 == config.ticks);
+            }
+            mockCurrentTick++;
+        }
+        double wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - runStart).count();
+
+        printf("  ],\n");
+        bool consistent = printSummary(wallMs);
+        printf("}\n");
+
+        if (recorder.isOpen()) {
+            mockStopRecording();
+            fprintf(stderr, "escrow_sim: %llu records written to %s\n",
+                    (unsigned long long)recorder.records(), config.tracePath);
+            recorder.close();
+        }
+        return consistent ? 0 : 1;
+    }
+
+private:
+    // ------------------------------------------------------------------
+    // Parties and keys
+    // ------------------------------------------------------------------
+
+    static id partyId(uint64 kind, uint64 index) {
+        id value;
+        memset(&value, 0, sizeof(id));
+        uint64 words[2] = { index + 1, kind };
+        memcpy(value.data, words, sizeof(words));
+        return value;
+    }
+
+    EscrowKey keyFor(uint32 slot) const {
+        const SimEscrow& escrow = escrows[slot];
+        EscrowKey key;
+        key.brandId = brandIds[escrow.brand];
+        key.influencerId = influencerIds[escrow.influencer];
+        key.campaignNonce = escrow.nonce;
+        return key;
+    }
+
+    // ------------------------------------------------------------------
+    // Pending and failing lists (swap-remove, O(1))
+    // ------------------------------------------------------------------
+
+    void listAdd(std::vector<uint32>& list, uint32 slot) {
+        escrows[slot].listPos = (uint32)list.size();
+        list.push_back(slot);
+    }
+
+    void listRemove(std::vector<uint32>& list, uint32 slot) {
+        uint32 pos = escrows[slot].listPos;
+        uint32 last = list.back();
+        list[pos] = last;
+        escrows[last].listPos = pos;
+        list.pop_back();
+        escrows[slot].listPos = NOT_LISTED;
+    }
+
+    // ------------------------------------------------------------------
+    // Calls
+    // ------------------------------------------------------------------
+
+    SimOp pickOp() {
+        uint32 roll = random.below(totalWeight);
+        for (uint32 op = 0; op < OP_COUNT; op++) {
+            if (roll < config.weights[op]) {
+                return (SimOp)op;
+            }
+            roll -= config.weights[op];
+        }
+        return OP_QUERY;
+    }
+
+    void performCall(SimOp op) {
+        switch (op) {
+        case OP_DEPOSIT: deposit(); break;
+        case OP_DEPOSIT_BATCH: depositBatch(); break;
+        case OP_SCORE: score(); break;
+        case OP_SCORE_BATCH: scoreBatch(); break;
+        case OP_RELEASE: release(); break;
+        case OP_REFUND: refund(); break;
+        default: query(); break;
+        }
+    }
+
+    sint64 drawAmount() {
+        return MIN_DEPOSIT + (sint64)(random.next() % (uint64)(MAX_DEPOSIT - MIN_DEPOSIT));
+    }
+
+    uint8 drawScore() {
+        bool passes = random.below(100) < config.passPercent;
+        return passes
+            ? (uint8)(DEFAULT_REQUIRED_SCORE + random.below(101 - DEFAULT_REQUIRED_SCORE))
+            : (uint8)random.below(DEFAULT_REQUIRED_SCORE);
+    }
+
+    void recordDeposit(uint32 slot, uint32 brand, uint32 influencer, uint64 nonce) {
+        SimEscrow& escrow = escrows[slot];
+        if (escrow.phase != SIM_FREE) {
+            modelErrors++;
+            return;
+        }
+        escrow.nonce = nonce;
+        escrow.brand = brand;
+        escrow.influencer = influencer;
+        escrow.retentionEndTick = mockCurrentTick + config.retentionDays * 14400;
+        escrow.phase = SIM_PENDING;
+        listAdd(pending, slot);
+        activeCount++;
+        window.deposited++;
+    }
+
+    void deposit() {
+        if (activeCount >= config.escrows) {
+            return;
+        }
+        uint32 brand = random.below(config.brands);
+        uint32 influencer = random.below(config.influencers);
+
+        DepositInput input;
+        memset(&input, 0, sizeof(input));
+        input.amount = drawAmount();
+        input.influencerId = influencerIds[influencer];
+        input.retentionDays = config.retentionDays;
+        input.campaignNonce = ++nonceCounter;
+
+        // The output is only written on success, so check the debit
+        sint64 before = mockGetBalance(brandIds[brand]);
+        DepositOutput output;
+        mockSetCaller(brandIds[brand]);
+        CALL_PROCEDURE_OUT(depositFunds, &input, sizeof(DepositInput), &output, sizeof(DepositOutput));
+        window.calls++;
+
+        if (mockGetBalance(brandIds[brand]) == before) {
+            window.rejected++;
+            return;
+        }
+        recordDeposit(output.slot, brand, influencer, input.campaignNonce);
+    }
+
+    void depositBatch() {
+        if (activeCount >= config.escrows) {
+            return;
+        }
+        uint32 count = config.batch;
+        if (config.escrows - activeCount < count) {
+            count = config.escrows - activeCount;
+        }
+        uint32 brand = random.below(config.brands);
+        uint32 firstInfluencer = random.below(config.influencers);
+
+        std::vector<uint8> input(sizeof(DepositBatchHeader) + count * sizeof(DepositBatchEntry), 0);
+        DepositBatchHeader header;
+        memset(&header, 0, sizeof(header));
+        header.campaignNonce = ++nonceCounter;
+        header.count = count;
+        for (uint32 i = 0; i < count; i++) {
+            DepositBatchEntry entry;
+            memset(&entry, 0, sizeof(entry));
+            entry.influencerId = influencerIds[(firstInfluencer + i) % config.influencers];
+            entry.amount = drawAmount();
+            entry.retentionDays = config.retentionDays;
+            header.totalAmount += entry.amount;
+            memcpy(input.data() + sizeof(DepositBatchHeader) + i * sizeof(DepositBatchEntry), &entry, sizeof(entry));
+        }
+        memcpy(input.data(), &header, sizeof(header));
+
+        DepositBatchOutput output;
+        mockSetCaller(brandIds[brand]);
+        CALL_PROCEDURE_OUT(depositFundsBatch, input.data(), input.size(), &output, sizeof(DepositBatchOutput));
+        window.calls++;
+
+        if (output.count == 0) {
+            window.rejected += count;
+            return;
+        }
+        for (uint32 i = 0; i < output.count; i++) {
+            recordDeposit(output.slots[i], brand, (firstInfluencer + i) % config.influencers, header.campaignNonce);
+        }
+    }
+
+    void recordScore(uint32 slot, uint8 value) {
+        listRemove(pending, slot);
+        if (value >= DEFAULT_REQUIRED_SCORE) {
+            escrows[slot].phase = SIM_PASSING;
+            due.push(DueEntry(escrows[slot].retentionEndTick, slot));
+        } else {
+            escrows[slot].phase = SIM_FAILING;
+            listAdd(failing, slot);
+        }
+    }
+
+    void score() {
+        if (pending.empty()) {
+            return;
+        }
+        uint32 slot = pending[random.below((uint32)pending.size())];
+
+        ScoreInput input;
+        memset(&input, 0, sizeof(input));
+        input.key = keyFor(slot);
+        input.score = drawScore();
+
+        mockSetCaller(ORACLE_ID);
+        CALL_PROCEDURE(setVerificationScore, &input, sizeof(ScoreInput));
+        window.calls++;
+        recordScore(slot, input.score);
+    }
+
+    void scoreBatch() {
+        if (pending.empty()) {
+            return;
+        }
+        uint32 count = config.batch < pending.size() ? config.batch : (uint32)pending.size();
+
+        // Distinct slots: take from the tail of a partial shuffle of the list
+        std::vector<ScoreBatchEntry> entries(count);
+        for (uint32 i = 0; i < count; i++) {
+            uint32 remaining = (uint32)pending.size() - i;
+            uint32 pick = random.below(remaining);
+            std::swap(pending[pick], pending[remaining - 1]);
+            escrows[pending[pick]].listPos = pick;
+            escrows[pending[remaining - 1]].listPos = remaining - 1;
+
+            memset(&entries[i], 0, sizeof(ScoreBatchEntry));
+            entries[i].slot = pending[remaining - 1];
+            entries[i].depositTick = state.escrows[entries[i].slot].depositTick;
+            entries[i].score = drawScore();
+        }
+
+        std::vector<uint8> input(SCORE_BATCH_HEADER_SIZE + count * sizeof(ScoreBatchEntry));
+        memcpy(input.data(), &count, sizeof(uint32));
+        memcpy(input.data() + SCORE_BATCH_HEADER_SIZE, entries.data(), count * sizeof(ScoreBatchEntry));
+
+        ScoreBatchOutput output;
+        mockSetCaller(ORACLE_ID);
+        CALL_PROCEDURE_OUT(setVerificationScoreBatch, input.data(), input.size(), &output, sizeof(ScoreBatchOutput));
+        window.calls++;
+
+        if (output.applied != count) {
+            modelErrors++;
+        }
+        for (const ScoreBatchEntry& entry : entries) {
+            recordScore(entry.slot, entry.score);
+        }
+    }
+
+    void release() {
+        // Drop entries that END_TICK settled in the meantime
+        while (!due.empty() && escrows[due.top().second].phase != SIM_PASSING) {
+            due.pop();
+        }
+        if (due.empty() || due.top().first > mockCurrentTick) {
+            return;
+        }
+        uint32 slot = due.top().second;
+        due.pop();
+
+        EscrowKey key = keyFor(slot);
+        mockSetCaller(brandIds[escrows[slot].brand]);
+        CALL_PROCEDURE(releasePayment, &key, sizeof(EscrowKey));
+        window.calls++;
+    }
+
+    void refund() {
+        if (failing.empty()) {
+            return;
+        }
+        uint32 slot = failing[random.below((uint32)failing.size())];
+        listRemove(failing, slot);
+
+        EscrowKey key = keyFor(slot);
+        mockSetCaller(brandIds[escrows[slot].brand]);
+        CALL_PROCEDURE(refundFunds, &key, sizeof(EscrowKey));
+        window.calls++;
+    }
+
+    void query() {
+        if (state.escrowCount == 0) {
+            return;
+        }
+        uint32 slot = random.below(state.escrowCount);
+        if (escrows[slot].phase == SIM_FREE) {
+            return;
+        }
+
+        EscrowKey key = keyFor(slot);
+        StateResponse output;
+        CALL_FUNCTION_WITH_INPUT(getContractState, &key, sizeof(EscrowKey), &output, sizeof(StateResponse));
+        window.calls++;
+    }
+
+    // ------------------------------------------------------------------
+    // Events
+    // ------------------------------------------------------------------
+
+    /*
+     * Follow the event ring up to the newest event
+     * afterEndTick marks settlements as END_TICK work rather than a call's.
+     */
+    void drainEvents(bool afterEndTick) {
+        while (true) {
+            EventsInput input;
+            input.afterSequence = lastSequence;
+            EventsOutput output;
+            CALL_FUNCTION_WITH_INPUT(getEventsSince, &input, sizeof(EventsInput), &output, sizeof(EventsOutput));
+
+            if (output.count > 0 && output.oldestSequence > lastSequence + 1) {
+                missedEvents += output.oldestSequence - lastSequence - 1;
+            }
+            for (uint32 i = 0; i < output.count; i++) {
+                applyEvent(output.events[i], afterEndTick);
+                lastSequence = output.events[i].sequence;
+            }
+            if (output.count < EVENT_PAGE_SIZE || lastSequence >= output.latestSequence) {
+                return;
+            }
+        }
+    }
+
+    void applyEvent(const EscrowEvent& event, bool afterEndTick) {
+        if (event.slot >= MAX_ESCROWS) {
+            return;
+        }
+        SimEscrow& escrow = escrows[event.slot];
+
+        switch (event.kind) {
+        case EVENT_RELEASED:
+        case EVENT_REFUNDED:
+            if (escrow.phase != SIM_PASSING && escrow.phase != SIM_FAILING) {
+                modelErrors++;
+                return;
+            }
+            if (escrow.phase == SIM_FAILING && escrow.listPos != NOT_LISTED) {
+                listRemove(failing, event.slot);
+            }
+            escrow.phase = SIM_SETTLED;
+            activeCount--;
+            if (event.kind == EVENT_RELEASED) {
+                window.released++;
+            } else {
+                window.refunded++;
+            }
+            if (afterEndTick) {
+                window.autoSettled++;
+            }
+            break;
+        case EVENT_RECLAIMED:
+            if (escrow.phase != SIM_SETTLED) {
+                modelErrors++;
+            }
+            escrow.phase = SIM_FREE;
+            window.reclaimed++;
+            break;
+        default:
+            break;
+        }
+    }
+
+    // ------------------------------------------------------------------
+    // Reporting
+    // ------------------------------------------------------------------
+
+    void printConfig() const {
+        printf("  \"config\": {\"escrows\": %u, \"ticks\": %u, \"calls\": %u, \"seed\": %llu, \"batch\": %u, "
+               "\"pass\": %u, \"retention\": %u, \"brands\": %u, \"influencers\": %u, \"sample\": %u, \"mix\": {",
+               config.escrows, config.ticks, config.calls, (unsigned long long)config.seed, config.batch,
+               config.passPercent, config.retentionDays, config.brands, config.influencers, config.sampleTicks);
+        for (uint32 op = 0; op < OP_COUNT; op++) {
+            printf("%s\"%s\": %u", op == 0 ? "" : ", ", OP_NAMES[op], config.weights[op]);
+        }
+        printf("}},\n");
+    }
+
+    AggregatesOutput queryAggregates() {
+        AggregatesOutput output;
+        CALL_FUNCTION(getAggregates, &output, sizeof(AggregatesOutput));
+        return output;
+    }
+
+    void printSample(bool last) {
+        AggregatesOutput aggregates = queryAggregates();
+        uint32 indexed = MAX_ESCROWS - aggregates.availableSlots;
+
+        printf("    {\"tick\": %u, \"calls\": %llu, \"deposited\": %llu, \"rejected\": %llu, "
+               "\"released\": %llu, \"refunded\": %llu, \"autoSettled\": %llu, \"maxAutoSettled\": %u, "
+               "\"reclaimed\": %llu, \"endTickNsMean\": %.1f, \"endTickNsMax\": %.1f, "
+               "\"active\": %u, \"queued\": %u, \"highWater\": %u, \"indexLoad\": %.4f, \"ledgerAccounts\": %u}%s\n",
+               mockCurrentTick, (unsigned long long)window.calls, (unsigned long long)window.deposited,
+               (unsigned long long)window.rejected, (unsigned long long)window.released,
+               (unsigned long long)window.refunded, (unsigned long long)window.autoSettled,
+               window.maxAutoSettled, (unsigned long long)window.reclaimed,
+               window.endTickNsTotal / window.ticks, window.endTickNsMax,
+               aggregates.pendingCount + aggregates.verifiedCount, aggregates.queuedSettlements,
+               state.escrowCount, (double)indexed / ESCROW_INDEX_SIZE, mockLedgerSize(), last ? "" : ",");
+
+        totals.calls += window.calls;
+        totals.deposited += window.deposited;
+        totals.rejected += window.rejected;
+        totals.released += window.released;
+        totals.refunded += window.refunded;
+        totals.autoSettled += window.autoSettled;
+        totals.reclaimed += window.reclaimed;
+        totals.endTickNsTotal += window.endTickNsTotal;
+        totals.ticks += window.ticks;
+        if (window.maxAutoSettled > totals.maxAutoSettled) {
+            totals.maxAutoSettled = window.maxAutoSettled;
+        }
+        if (window.endTickNsMax > totals.endTickNsMax) {
+            totals.endTickNsMax = window.endTickNsMax;
+        }
+        memset(&window, 0, sizeof(window));
+    }
+
+    /*
+     * Print totals and cross-check the generator's model, the contract's
+     * aggregates and the ledger; returns true if they all agree
+     */
+    bool printSummary(double wallMs) {
+        AggregatesOutput aggregates = queryAggregates();
+
+        uint32 passingOrFailing = 0;
+        for (const SimEscrow& escrow : escrows) {
+            passingOrFailing += escrow.phase == SIM_PASSING || escrow.phase == SIM_FAILING;
+        }
+        bool modelInSync = modelErrors == 0 && missedEvents == 0 &&
+            aggregates.pendingCount == pending.size() &&
+            aggregates.verifiedCount == passingOrFailing &&
+            aggregates.pendingCount + aggregates.verifiedCount == activeCount;
+
+        // Every unit a brand was funded with is still somewhere on the ledger
+        sint64 ledgerTotal = mockContractBalance + mockGetBalance(OWNER_ID);
+        for (const id& brand : brandIds) {
+            ledgerTotal += mockGetBalance(brand);
+        }
+        for (const id& influencer : influencerIds) {
+            ledgerTotal += mockGetBalance(influencer);
+        }
+        bool conserved = ledgerTotal == BRAND_FUNDS * (sint64)config.brands;
+        bool balanced = aggregates.lockedBalance + aggregates.lockedFees + aggregates.accruedFees == mockContractBalance;
+
+        printf("  \"summary\": {\"ticks\": %u, \"calls\": %llu, \"wallMs\": %.1f, \"callsPerSecond\": %.0f, "
+               "\"ticksPerSecond\": %.0f, \"deposited\": %llu, \"rejected\": %llu, \"released\": %llu, "
+               "\"refunded\": %llu, \"autoSettled\": %llu, \"maxAutoSettled\": %u, \"reclaimed\": %llu, "
+               "\"endTickNsMean\": %.1f, \"endTickNsMax\": %.1f, \"eventSequence\": %llu, "
+               "\"sweptFees\": %lld, \"modelInSync\": %s, \"ledgerConserved\": %s, \"contractBalanced\": %s}\n",
+               totals.ticks, (unsigned long long)totals.calls, wallMs,
+               wallMs > 0 ? totals.calls * 1000.0 / wallMs : 0.0,
+               wallMs > 0 ? totals.ticks * 1000.0 / wallMs : 0.0,
+               (unsigned long long)totals.deposited, (unsigned long long)totals.rejected,
+               (unsigned long long)totals.released, (unsigned long long)totals.refunded,
+               (unsigned long long)totals.autoSettled, totals.maxAutoSettled,
+               (unsigned long long)totals.reclaimed, totals.endTickNsTotal / totals.ticks,
+               totals.endTickNsMax, (unsigned long long)state.eventSequence,
+               (long long)aggregates.sweptFees, modelInSync ? "true" : "false",
+               conserved ? "true" : "false", balanced ? "true" : "false");
+        return modelInSync && conserved && balanced;
+    }
+
+    typedef std::pair<uint32, uint32> DueEntry;  // (retentionEndTick, slot)
+
+    SimConfig config;
+    uint32 totalWeight;
+    SimRandom random;
+
+    std::vector<id> brandIds;
+    std::vector<id> influencerIds;
+    std::vector<SimEscrow> escrows;     // Indexed by contract slot
+    std::vector<uint32> pending;
+    std::vector<uint32> failing;
+    std::priority_queue<DueEntry, std::vector<DueEntry>, std::greater<DueEntry> > due;
+
+    uint32 activeCount;
+    uint64 nonceCounter;
+    uint64 lastSequence;
+    uint64 missedEvents;
+    uint64 modelErrors;
+
+    SimWindow window;
+    SimWindow totals;
+    QpiTraceRecorder recorder;
+};
+
+int main(int argc, char** argv) {
+    SimConfig config = defaultConfig();
+    for (int i = 1; i < argc; i++) {
+        if (!parseOption(config, argv[i])) {
+            fprintf(stderr, "escrow_sim: bad option '%s' (expected key=value, see the header of escrow.sim.cpp)\n", argv[i]);
+            return 2;
+        }
+    }
+    const char* error = validateConfig(config);
+    if (error != nullptr) {
+        fprintf(stderr, "escrow_sim: %s\n", error);
+        return 2;
+    }
+
+    std::unique_ptr<TickSimulator> simulator(new TickSimulator(config));
+    return simulator->run();
+}
@@ -0,0 +1,30 @@
+/*
+ * Public entry points of escrow.qpi by name, for trace replay
+ * Include after defining EscrowContract; names match what the CALL_*
+ * macros record, so add every new PUBLIC_PROCEDURE / PUBLIC_FUNCTION here.
+ */
+
+#pragma once
+
+static const QpiTraceReplayer<EscrowContract>::Entry ESCROW_ENTRY_POINTS[] = {
+    { "setOracleId", &EscrowContract::setOracleId },
+    { "setOracleSet", &EscrowContract::setOracleSet },
+    { "depositFunds", &EscrowContract::depositFunds },
+    { "depositFundsBatch", &EscrowContract::depositFundsBatch },
+    { "depositStream", &EscrowContract::depositStream },
+    { "setVerificationScore", &EscrowContract::setVerificationScore },
+    { "setVerificationScoreBatch", &EscrowContract::setVerificationScoreBatch },
+    { "submitCosignedScores", &EscrowContract::submitCosignedScores },
+    { "releasePayment", &EscrowContract::releasePayment },
+    { "refundFunds", &EscrowContract::refundFunds },
+    { "claimStream", &EscrowContract::claimStream },
+    { "getContractState", &EscrowContract::getContractState },
+    { "getStream", &EscrowContract::getStream },
+    { "getEscrowsPage", &EscrowContract::getEscrowsPage },
+    { "getEventsSince", &EscrowContract::getEventsSince },
+    { "getAggregates", &EscrowContract::getAggregates },
+};
+
+inline QpiTraceReplayer<EscrowContract> escrowReplayer() {
+    return QpiTraceReplayer<EscrowContract>(ESCROW_ENTRY_POINTS, sizeof(ESCROW_ENTRY_POINTS) / sizeof(ESCROW_ENTRY_POINTS[0]));
+}
@@ -0,0 +1,9 @@
+/*
+ * QPI stand-in for native test builds
+ * Contracts include "qpi.h"; with -I contracts/test that resolves here and
+ * pulls in the mock, so the contract source compiles unchanged in tests.
+ */
+
+#pragma once
+
+#include "qpi_test.h"
@@ -0,0 +1,714 @@
+/*
+ * QPI Test Harness
+ * Mock QPI for running contracts natively, one isolated instance per test
+ *
+ * A contract is compiled as the body of a class deriving from
+ * QpiContractInstance:
+ *
+ *   #include "qpi_test.h"
+ *   #include "../src/escrow_wire.h"
+ *
+ *   class EscrowContract : public QpiContractInstance {
+ *   public:
+ *   #include "../src/escrow.qpi"
+ *   };
+ *
+ * The contract's state becomes a member, PRIVATE / PUBLIC_* / END_TICK
+ * become member functions and `qpi` resolves to the instance's own
+ * QpiContext. Tick, caller, ledger and I/O buffers live on the instance
+ * too, so nothing is shared and tests can run on a thread pool.
+ *
+ * Build with -I contracts/test so the contract's #include "qpi.h" finds the
+ * stand-in next to this file.
+ */
+
+#ifndef QPI_TEST_H
+#define QPI_TEST_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ============================================================================
+// QPI BASE TYPES
+// ============================================================================
+
+typedef uint8_t uint8;
+typedef uint16_t uint16;
+typedef uint32_t uint32;
+typedef uint64_t uint64;
+typedef int8_t sint8;
+typedef int16_t sint16;
+typedef int32_t sint32;
+typedef int64_t sint64;
+
+// 32-byte public key
+struct id {
+    uint8 data[32];
+};
+
+/*
+ * Decode a 60-letter identity (A-Z) to its public key
+ * Same base-26 grouping as the agent's identityToPublicKey: four groups of
+ * 14 letters, least significant first; the 4-letter checksum is ignored.
+ * Shorter test identities are treated as padded with 'A'.
+ */
+inline void stringToId(const char* identity, id* publicKey) {
+    size_t length = strlen(identity);
+    for (uint32 word = 0; word < 4; word++) {
+        uint64 value = 0;
+        for (uint32 i = 14; i-- > 0;) {
+            size_t pos = word * 14 + i;
+            char letter = pos < length ? identity[pos] : 'A';
+            value = value * 26 + (uint64)(letter - 'A');
+        }
+        memcpy(publicKey->data + word * 8, &value, sizeof(uint64));
+    }
+}
+
+inline id qpiTestId(const id& value) {
+    return value;
+}
+
+inline id qpiTestId(const char* identity) {
+    id value;
+    stringToId(identity, &value);
+    return value;
+}
+
+// ============================================================================
+// MOCK LEDGER
+// ============================================================================
+
+/*
+ * Balances keyed by public key
+ * Flat open-addressed table with linear probing over one arena block:
+ * keys compare as four 64-bit words and lookups never allocate. The table
+ * doubles (one rehash into a fresh block) when it passes half full, so the
+ * allocation cost is amortised over many new accounts instead of paid per
+ * call.
+ */
+class QpiLedger {
+public:
+    explicit QpiLedger(uint32 initialCapacity = 1024) : capacity(0), count(0) {
+        uint32 size = 16;
+        while (size < initialCapacity) {
+            size <<= 1;
+        }
+        allocate(size);
+    }
+
+    QpiLedger(const QpiLedger&) = delete;
+    QpiLedger& operator=(const QpiLedger&) = delete;
+
+    // Balance of an account, 0 if it has never been credited
+    sint64 get(const id& publicKey) const {
+        uint64 key[4];
+        loadKey(publicKey, key);
+        const Entry* entry = find(key);
+        return entry != nullptr ? entry->balance : 0;
+    }
+
+    // Mutable balance, inserting a zero-balance account if needed
+    sint64& at(const id& publicKey) {
+        uint64 key[4];
+        loadKey(publicKey, key);
+        Entry* entry = find(key);
+        if (entry != nullptr) {
+            return entry->balance;
+        }
+
+        if ((count + 1) * 2 > capacity) {
+            grow();
+        }
+        entry = &entries[probeEmpty(key)];
+        memcpy(entry->key, key, sizeof(key));
+        entry->balance = 0;
+        entry->occupied = 1;
+        count++;
+        return entry->balance;
+    }
+
+    uint32 size() const {
+        return count;
+    }
+
+    void clear() {
+        memset(entries.get(), 0, sizeof(Entry) * capacity);
+        count = 0;
+    }
+
+private:
+    struct Entry {
+        uint64 key[4];
+        sint64 balance;
+        uint64 occupied;    // 0 = empty slot (the all-zero key is a valid account)
+    };
+
+    static void loadKey(const id& publicKey, uint64 key[4]) {
+        memcpy(key, publicKey.data, sizeof(id));
+    }
+
+    static uint64 hashKey(const uint64 key[4]) {
+        uint64 h = 0x9E3779B97F4A7C15ULL;
+        for (uint32 i = 0; i < 4; i++) {
+            h ^= key[i];
+            h *= 0xBF58476D1CE4E5B9ULL;
+            h ^= h >> 31;
+        }
+        return h;
+    }
+
+    Entry* find(const uint64 key[4]) const {
+        uint32 mask = capacity - 1;
+        for (uint32 pos = (uint32)hashKey(key) & mask;; pos = (pos + 1) & mask) {
+            Entry& entry = entries[pos];
+            if (!entry.occupied) {
+                return nullptr;
+            }
+            if (entry.key[0] == key[0] && entry.key[1] == key[1] &&
+                entry.key[2] == key[2] && entry.key[3] == key[3]) {
+                return &entry;
+            }
+        }
+    }
+
+    uint32 probeEmpty(const uint64 key[4]) const {
+        uint32 mask = capacity - 1;
+        uint32 pos = (uint32)hashKey(key) & mask;
+        while (entries[pos].occupied) {
+            pos = (pos + 1) & mask;
+        }
+        return pos;
+    }
+
+    void allocate(uint32 size) {
+        entries.reset(new Entry[size]);
+        memset(entries.get(), 0, sizeof(Entry) * size);
+        capacity = size;
+    }
+
+    void grow() {
+        std::unique_ptr<Entry[]> old(entries.release());
+        uint32 oldCapacity = capacity;
+        allocate(capacity * 2);
+        for (uint32 i = 0; i < oldCapacity; i++) {
+            if (old[i].occupied) {
+                entries[probeEmpty(old[i].key)] = old[i];
+            }
+        }
+    }
+
+    std::unique_ptr<Entry[]> entries;
+    uint32 capacity;    // Power of two
+    uint32 count;
+};
+
+// Call trace recording and replay
+#include "qpi_trace.h"
+
+// ============================================================================
+// MOCK CRYPTOGRAPHY
+// ============================================================================
+
+/*
+ * Stand-in for the K12 digest: 32 deterministic bytes from four seeded
+ * qpiTraceHash lanes. Collision resistance is not the point, only that the
+ * contract hashes the bytes an off-chain signer saw.
+ */
+inline void qpiTestDigest(const void* data, uint64 size, id* digest) {
+    for (uint32 i = 0; i < 4; i++) {
+        uint64 lane = qpiTraceHash(data, size, 0x4B3132ULL + i);
+        memcpy(digest->data + i * 8, &lane, sizeof(uint64));
+    }
+}
+
+/*
+ * Stand-in signature of a digest by an entity
+ * Verification recomputes it, so only "signing" with the right public key
+ * over the right digest passes. Tests use this in place of SchnorrQ.
+ */
+inline void qpiTestSign(const id& signer, const id& digest, uint8 signature[64]) {
+    uint8 message[sizeof(id) * 2];
+    memcpy(message, &signer, sizeof(id));
+    memcpy(message + sizeof(id), &digest, sizeof(id));
+    for (uint32 i = 0; i < 8; i++) {
+        uint64 lane = qpiTraceHash(message, sizeof(message), 0x5349474EULL + i);
+        memcpy(signature + i * 8, &lane, sizeof(uint64));
+    }
+}
+
+// ============================================================================
+// CONTRACT INSTANCE
+// ============================================================================
+
+class QpiContractInstance;
+
+/*
+ * The `qpi` object seen by contract code
+ * Every call reads or writes the owning instance only.
+ */
+class QpiContext {
+public:
+    explicit QpiContext(QpiContractInstance& instance) : instance(instance) {}
+
+    // Memory
+    void setMem(void* destination, uint8 value, uint64 size) const {
+        memset(destination, value, size);
+    }
+    void copyMem(void* destination, const void* source, uint64 size) const {
+        memcpy(destination, source, size);
+    }
+    bool compareMem(const void* left, const void* right, uint64 size) const {
+        return memcmp(left, right, size) == 0;
+    }
+
+    // Invocation input / output
+    inline void getInput(uint64 offset, void* destination, uint64 size) const;
+    inline uint32 getInputSize() const;
+    inline void setOutput(const void* source, uint64 size) const;
+
+    // Context
+    inline void getSourcePublicKey(id* publicKey) const;
+    inline void getContractOwner(id* publicKey) const;
+    inline const id* getContractId() const;
+    inline uint32 getCurrentTick() const;
+    inline uint16 getEpoch() const;
+
+    // Value transfer: to getContractId() pulls from the invocation source,
+    // anything else pays out of the contract balance
+    inline bool transfer(const id* destination, sint64 amount) const;
+
+    // Cryptography (mock stand-ins, see qpiTestDigest / qpiTestSign)
+    void K12(const void* data, uint64 size, id* digest) const {
+        qpiTestDigest(data, size, digest);
+    }
+    bool signatureValidity(const id* entity, const id* digest, const void* signature) const {
+        uint8 expected[64];
+        qpiTestSign(*entity, *digest, expected);
+        return memcmp(expected, signature, sizeof(expected)) == 0;
+    }
+
+    void logMessage(const char* message) const {
+        (void)message;
+    }
+
+private:
+    QpiContractInstance& instance;
+};
+
+/*
+ * One deployed contract plus the chain around it
+ * Tests drive the mock* members directly; the CALL_* macros route
+ * invocation input and output through the instance.
+ */
+class QpiContractInstance {
+public:
+    QpiContractInstance()
+        : qpi(*this),
+          mockCurrentTick(0),
+          mockCurrentEpoch(0),
+          mockContractBalance(0),
+          recorder(nullptr),
+          callContractBalance(0),
+          callInput(nullptr),
+          callInputSize(0),
+          callOutput(nullptr),
+          callOutputSize(0) {
+        memset(&caller, 0, sizeof(id));
+        stringToId("OWNERAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA", &owner);
+        stringToId("CONTRACTAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA", &contractId);
+    }
+
+    QpiContractInstance(const QpiContractInstance&) = delete;
+    QpiContractInstance& operator=(const QpiContractInstance&) = delete;
+
+protected:
+    QpiContext qpi;
+
+public:
+    uint32 mockCurrentTick;
+    uint16 mockCurrentEpoch;
+    sint64 mockContractBalance;  // Funds held by the contract itself
+
+    void mockSetCaller(const char* identity) {
+        stringToId(identity, &caller);
+    }
+
+    void mockSetCaller(const id& publicKey) {
+        caller = publicKey;
+    }
+
+    void mockSetOwner(const char* identity) {
+        mockSetOwner(qpiTestId(identity));
+    }
+
+    void mockSetOwner(const id& publicKey) {
+        owner = publicKey;
+        if (recorder != nullptr) {
+            recorder->recordAccount(QPI_TRACE_SET_OWNER, owner, 0, mockCurrentTick, mockCurrentEpoch);
+        }
+    }
+
+    void mockSetBalance(const char* identity, sint64 balance) {
+        mockSetBalance(qpiTestId(identity), balance);
+    }
+
+    void mockSetBalance(const id& publicKey, sint64 balance) {
+        ledger.at(publicKey) = balance;
+        if (recorder != nullptr) {
+            recorder->recordAccount(QPI_TRACE_SET_BALANCE, publicKey, balance, mockCurrentTick, mockCurrentEpoch);
+        }
+    }
+
+    sint64 mockGetBalance(const char* identity) const {
+        return ledger.get(qpiTestId(identity));
+    }
+
+    sint64 mockGetBalance(const id& publicKey) const {
+        return ledger.get(publicKey);
+    }
+
+    // Accounts the ledger has seen (the contract's own balance is separate)
+    uint32 mockLedgerSize() const {
+        return ledger.size();
+    }
+
+    // Append every following CALL_* and ledger change to an open recorder
+    // (writes the test makes to contract state directly are not recorded)
+    void mockStartRecording(QpiTraceRecorder* traceRecorder) {
+        recorder = traceRecorder;
+    }
+
+    void mockStopRecording() {
+        recorder = nullptr;
+    }
+
+    // Invocation plumbing for the CALL_* macros
+    void mockBeginCall(const void* input, uint64 inputSize, void* output, uint64 outputSize) {
+        callContractBalance = mockContractBalance;
+        callInput = static_cast<const uint8*>(input);
+        callInputSize = input != nullptr ? inputSize : 0;
+        callOutput = output;
+        callOutputSize = output != nullptr ? outputSize : 0;
+        if (callOutput != nullptr) {
+            memset(callOutput, 0, callOutputSize);
+        }
+    }
+
+    // Records the finished call when recording; name is null for END_TICK / END_EPOCH
+    void mockEndCall(QpiTraceKind kind, const char* name) {
+        if (recorder != nullptr) {
+            recorder->recordCall(kind, name, caller, mockCurrentTick, mockCurrentEpoch, callContractBalance,
+                                 callInput, callInputSize, callOutput, callOutputSize);
+        }
+        mockEndCall();
+    }
+
+    void mockEndCall() {
+        callInput = nullptr;
+        callInputSize = 0;
+        callOutput = nullptr;
+        callOutputSize = 0;
+    }
+
+private:
+    friend class QpiContext;
+
+    id caller;
+    id owner;
+    id contractId;
+    QpiLedger ledger;  // Balances of everyone but the contract
+    QpiTraceRecorder* recorder;
+
+    sint64 callContractBalance;  // Contract balance when the current call began
+
+    const uint8* callInput;
+    uint64 callInputSize;
+    void* callOutput;
+    uint64 callOutputSize;
+};
+
+/*
+ * Copy input bytes; anything past the end of the input reads as zero
+ */
+inline void QpiContext::getInput(uint64 offset, void* destination, uint64 size) const {
+    memset(destination, 0, size);
+    if (offset < instance.callInputSize) {
+        uint64 available = instance.callInputSize - offset;
+        memcpy(destination, instance.callInput + offset, size < available ? size : available);
+    }
+}
+
+inline uint32 QpiContext::getInputSize() const {
+    return (uint32)instance.callInputSize;
+}
+
+/*
+ * Copy output bytes, truncated to the caller's buffer
+ */
+inline void QpiContext::setOutput(const void* source, uint64 size) const {
+    if (instance.callOutput != nullptr) {
+        memcpy(instance.callOutput, source, size < instance.callOutputSize ? size : instance.callOutputSize);
+    }
+}
+
+inline void QpiContext::getSourcePublicKey(id* publicKey) const {
+    *publicKey = instance.caller;
+}
+
+inline void QpiContext::getContractOwner(id* publicKey) const {
+    *publicKey = instance.owner;
+}
+
+inline const id* QpiContext::getContractId() const {
+    return &instance.contractId;
+}
+
+inline uint32 QpiContext::getCurrentTick() const {
+    return instance.mockCurrentTick;
+}
+
+inline uint16 QpiContext::getEpoch() const {
+    return instance.mockCurrentEpoch;
+}
+
+inline bool QpiContext::transfer(const id* destination, sint64 amount) const {
+    if (amount < 0) {
+        return false;
+    }
+
+    // Invocation amount: source -> contract
+    if (memcmp(destination, &instance.contractId, sizeof(id)) == 0) {
+        sint64& source = instance.ledger.at(instance.caller);
+        if (source < amount) {
+            return false;
+        }
+        source -= amount;
+        instance.mockContractBalance += amount;
+        return true;
+    }
+
+    // Payout: contract -> destination
+    if (instance.mockContractBalance < amount) {
+        return false;
+    }
+    instance.mockContractBalance -= amount;
+    instance.ledger.at(*destination) += amount;
+    return true;
+}
+
+// ============================================================================
+// CONTRACT DEFINITION MACROS
+// ============================================================================
+
+#define PRIVATE
+#define PUBLIC_PROCEDURE(name) void name()
+#define PUBLIC_FUNCTION(name) void name()
+#define CONSTRUCTOR void contractConstructor()
+#define END_TICK void contractEndTick()
+#define END_EPOCH void contractEndEpoch()
+
+// ============================================================================
+// INVOCATION MACROS (used from fixture and test member functions)
+// ============================================================================
+
+#define CALL_PROCEDURE_OUT(name, input, inputSize, output, outputSize) \
+    do { \
+        mockBeginCall((input), (inputSize), (output), (outputSize)); \
+        name(); \
+        mockEndCall(QPI_TRACE_CALL, #name); \
+    } while (0)
+
+#define CALL_PROCEDURE(name, input, inputSize) CALL_PROCEDURE_OUT(name, input, inputSize, nullptr, 0)
+#define CALL_PROCEDURE_NO_ARGS(name) CALL_PROCEDURE_OUT(name, nullptr, 0, nullptr, 0)
+#define CALL_FUNCTION(name, output, outputSize) CALL_PROCEDURE_OUT(name, nullptr, 0, output, outputSize)
+#define CALL_FUNCTION_WITH_INPUT(name, input, inputSize, output, outputSize) \
+    CALL_PROCEDURE_OUT(name, input, inputSize, output, outputSize)
+
+#define CALL_END_TICK() \
+    do { \
+        mockBeginCall(nullptr, 0, nullptr, 0); \
+        contractEndTick(); \
+        mockEndCall(QPI_TRACE_END_TICK, nullptr); \
+    } while (0)
+
+#define CALL_END_EPOCH() \
+    do { \
+        mockBeginCall(nullptr, 0, nullptr, 0); \
+        contractEndEpoch(); \
+        mockEndCall(QPI_TRACE_END_EPOCH, nullptr); \
+        mockCurrentEpoch++; \
+    } while (0)
+
+// ============================================================================
+// ASSERTIONS
+// ============================================================================
+
+struct QpiTestFailure : std::runtime_error {
+    explicit QpiTestFailure(const std::string& message) : std::runtime_error(message) {}
+};
+
+inline void qpiTestFail(const char* file, int line, const std::string& message) {
+    throw QpiTestFailure(std::string(file) + ":" + std::to_string(line) + ": " + message);
+}
+
+// Operands are taken by value so static const members are never odr-used
+inline void qpiAssertEqual(long long actual, long long expected,
+                           const char* actualText, const char* expectedText,
+                           const char* file, int line) {
+    if (actual != expected) {
+        qpiTestFail(file, line, std::string("ASSERT_EQUAL(") + actualText + ", " + expectedText + "): " +
+                    std::to_string(actual) + " != " + std::to_string(expected));
+    }
+}
+
+#define ASSERT_TRUE(condition) \
+    do { \
+        if (!(condition)) qpiTestFail(__FILE__, __LINE__, "ASSERT_TRUE(" #condition ")"); \
+    } while (0)
+
+#define ASSERT_FALSE(condition) \
+    do { \
+        if (condition) qpiTestFail(__FILE__, __LINE__, "ASSERT_FALSE(" #condition ")"); \
+    } while (0)
+
+#define ASSERT_EQUAL(actual, expected) \
+    qpiAssertEqual(static_cast<long long>(actual), static_cast<long long>(expected), \
+                   #actual, #expected, __FILE__, __LINE__)
+
+#define ASSERT_ID_EQUAL(actual, expected) \
+    do { \
+        id qpiActual = qpiTestId(actual); \
+        id qpiExpected = qpiTestId(expected); \
+        if (memcmp(&qpiActual, &qpiExpected, sizeof(id)) != 0) \
+            qpiTestFail(__FILE__, __LINE__, "ASSERT_ID_EQUAL(" #actual ", " #expected ")"); \
+    } while (0)
+
+#define PASS(message) ((void)(message))
+
+// ============================================================================
+// TEST REGISTRATION AND PARALLEL RUNNER
+// ============================================================================
+
+// Each test is a fixture subclass; RUN_TEST gives every run a fresh instance
+#define TEST(fixture, name) \
+    struct name##_T : fixture { \
+        void run(); \
+    }; \
+    void name##_T::run()
+
+#define RUN_TEST(name) \
+    QpiTestRunner::registry().add(#name, [] { \
+        std::unique_ptr<name##_T> test(new name##_T()); \
+        test->run(); \
+    })
+
+/*
+ * Runs registered tests across a pool of worker threads
+ * Tests share nothing, so any order is valid; results are reported in
+ * registration order. QPI_TEST_THREADS overrides the worker count.
+ */
+class QpiTestRunner {
+public:
+    typedef void (*TestBody)();
+
+    static QpiTestRunner& registry() {
+        static QpiTestRunner runner;
+        return runner;
+    }
+
+    void add(const char* name, TestBody body) {
+        TestCase test;
+        test.name = name;
+        test.body = body;
+        tests.push_back(test);
+    }
+
+    void run(int& passed, int& failed) {
+        std::vector<Result> results(tests.size());
+        std::atomic<size_t> next(0);
+        unsigned threads = workerCount();
+
+        auto worker = [&]() {
+            for (size_t i = next++; i < tests.size(); i = next++) {
+                results[i] = runOne(tests[i].body);
+            }
+        };
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        std::vector<std::thread> pool;
+        for (unsigned i = 1; i < threads; i++) {
+            pool.emplace_back(worker);
+        }
+        worker();
+        for (std::thread& thread : pool) {
+            thread.join();
+        }
+        double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        for (size_t i = 0; i < tests.size(); i++) {
+            if (results[i].passed) {
+                printf("✓ %s passed\n", tests[i].name);
+                passed++;
+            } else {
+                printf("✗ %s FAILED: %s\n", tests[i].name, results[i].message.c_str());
+                failed++;
+            }
+        }
+        printf("\n  %zu tests on %u threads in %.1f ms\n", tests.size(), threads, elapsedMs);
+    }
+
+private:
+    struct TestCase {
+        const char* name;
+        TestBody body;
+    };
+
+    struct Result {
+        bool passed = false;
+        std::string message;
+    };
+
+    static Result runOne(TestBody body) {
+        Result result;
+        try {
+            body();
+            result.passed = true;
+        } catch (const std::exception& error) {
+            result.message = error.what();
+        } catch (...) {
+            result.message = "unknown exception";
+        }
+        return result;
+    }
+
+    unsigned workerCount() const {
+        unsigned threads = std::thread::hardware_concurrency();
+        const char* requested = getenv("QPI_TEST_THREADS");
+        if (requested != nullptr && atoi(requested) > 0) {
+            threads = (unsigned)atoi(requested);
+        }
+        if (threads == 0) {
+            threads = 1;
+        }
+        if (threads > tests.size() && !tests.empty()) {
+            threads = (unsigned)tests.size();
+        }
+        return threads;
+    }
+
+    std::vector<TestCase> tests;
+};
+
+#endif // QPI_TEST_H
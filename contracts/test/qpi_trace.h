@@ -0,0 +1,776 @@
+/*
+ * QPI Call Trace
+ * Record contract invocations and replay them bit-exactly against a build
+ *
+ * Included by qpi_test.h after the base types; not meant to be included on
+ * its own. A QpiTraceRecorder attached to a contract instance with
+ * mockStartRecording() receives every CALL_* made through that instance,
+ * plus the mockSetBalance / mockSetOwner calls that shape the ledger.
+ *
+ * File layout (little-endian, every record starts 8-byte aligned):
+ *   QpiTraceHeader
+ *   QpiTraceRecord, payload (inputSize bytes), zero padding to 8 - repeated
+ *
+ * A record carries everything an invocation can observe from outside the
+ * contract (caller, tick, epoch, contract balance, raw input, output size)
+ * and the hashes of its output and of the complete state after it ran.
+ * Entry point names are interned: the first use of a name is written as a
+ * QPI_TRACE_NAME record whose payload is the name; later records refer to
+ * it by index, in order of first use.
+ *
+ * The state hash is the XOR of one hash per 4 KiB chunk of state, so it
+ * can be kept current by rehashing only the chunks a call changed. The
+ * value depends only on the state bytes, never on how dirty chunks were
+ * found.
+ */
+
+#ifndef QPI_TRACE_H
+#define QPI_TRACE_H
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define QPI_TRACE_POSIX 1
+#endif
+
+// ============================================================================
+// FORMAT
+// ============================================================================
+
+static const char QPI_TRACE_MAGIC[8] = { 'Q', 'P', 'I', 'T', 'R', 'A', 'C', 'E' };
+static const uint32 QPI_TRACE_VERSION = 1;
+static const uint32 QPI_TRACE_CHUNK_SIZE = 4096;
+
+enum QpiTraceKind : uint8 {
+    QPI_TRACE_NAME = 1,          // Payload: entry point name (no terminator)
+    QPI_TRACE_CALL = 2,          // Procedure or function invocation
+    QPI_TRACE_END_TICK = 3,
+    QPI_TRACE_END_EPOCH = 4,
+    QPI_TRACE_SET_BALANCE = 5,   // account = caller, balance = new balance
+    QPI_TRACE_SET_OWNER = 6      // owner = caller
+};
+
+struct QpiTraceHeader {
+    char magic[8];               // QPI_TRACE_MAGIC
+    uint32 version;              // QPI_TRACE_VERSION
+    uint32 chunkSize;            // State hash chunk size
+    uint64 stateSize;            // sizeof(state) of the recording build
+    uint64 initialStateHash;     // State when recording started
+    uint64 recordCount;          // Patched on close, 0 if the recorder never closed
+};
+
+static_assert(sizeof(QpiTraceHeader) == 40, "QpiTraceHeader must stay padding-free");
+
+struct QpiTraceRecord {
+    uint8 kind;                  // QpiTraceKind
+    uint8 reserved0;
+    uint16 name;                 // Interned name index (QPI_TRACE_CALL)
+    uint16 epoch;
+    uint16 reserved1;
+    uint32 tick;
+    uint32 inputSize;            // Payload bytes that follow
+    uint32 outputSize;           // Output buffer the caller passed
+    uint32 reserved2;
+    sint64 balance;              // Contract balance before the call (SET_BALANCE: new balance)
+    id caller;                   // Invocation source (SET_BALANCE / SET_OWNER: the account)
+    uint64 outputHash;           // 0 without output
+    uint64 stateHash;            // Full state after the record
+};
+
+static_assert(offsetof(QpiTraceRecord, tick) == 8, "QpiTraceRecord layout changed");
+static_assert(offsetof(QpiTraceRecord, balance) == 24, "QpiTraceRecord layout changed");
+static_assert(offsetof(QpiTraceRecord, caller) == 32, "QpiTraceRecord layout changed");
+static_assert(sizeof(QpiTraceRecord) == 80, "QpiTraceRecord must stay padding-free");
+
+inline uint64 qpiTracePadded(uint64 size) {
+    return (size + 7) & ~(uint64)7;
+}
+
+// ============================================================================
+// HASHING
+// ============================================================================
+
+inline uint64 qpiTraceRotate(uint64 value, uint32 bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+/*
+ * 64-bit hash of a byte range: four multiply-rotate lanes over 32-byte
+ * blocks, byte tail, final avalanche. Reads words with memcpy, so the
+ * result is the same on any little-endian host.
+ */
+inline uint64 qpiTraceHash(const void* data, size_t size, uint64 seed) {
+    const uint64 P1 = 0x9E3779B185EBCA87ULL;
+    const uint64 P2 = 0xC2B2AE3D27D4EB4FULL;
+    const uint8* bytes = static_cast<const uint8*>(data);
+
+    uint64 lanes[4] = { seed + P1 + P2, seed + P2, seed, seed - P1 };
+    size_t pos = 0;
+    for (; pos + 32 <= size; pos += 32) {
+        for (uint32 lane = 0; lane < 4; lane++) {
+            uint64 word;
+            memcpy(&word, bytes + pos + lane * 8, sizeof(uint64));
+            lanes[lane] = qpiTraceRotate(lanes[lane] + word * P2, 31) * P1;
+        }
+    }
+
+    uint64 h = qpiTraceRotate(lanes[0], 1) + qpiTraceRotate(lanes[1], 7) +
+               qpiTraceRotate(lanes[2], 12) + qpiTraceRotate(lanes[3], 18);
+    h += (uint64)size * P1;
+    for (; pos < size; pos++) {
+        h = qpiTraceRotate(h ^ (bytes[pos] * P1), 11) * P2;
+    }
+
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+class QpiStateHash;
+
+#ifdef QPI_TRACE_POSIX
+inline QpiStateHash*& qpiTraceTrapOwner() {
+    static QpiStateHash* owner = nullptr;
+    return owner;
+}
+
+inline void qpiTraceWriteFault(int signo, siginfo_t* info, void* context);
+#endif
+
+/*
+ * Incrementally maintained hash of a contract's state
+ *
+ * Compare mode keeps a shadow copy and rehashes the chunks whose bytes
+ * changed; it works anywhere and on any thread. Trap mode write-protects
+ * the state and learns the dirty pages from the first write fault on each,
+ * so an update costs only the pages a call wrote. Trap mode is POSIX only,
+ * one instance per process at a time, and meant for single-threaded tools;
+ * when it cannot be had the hash falls back to compare mode.
+ */
+class QpiStateHash {
+public:
+    QpiStateHash(const void* stateData, size_t stateSize, bool trapWrites)
+        : state(static_cast<const uint8*>(stateData)),
+          size(stateSize),
+          chunks((stateSize + QPI_TRACE_CHUNK_SIZE - 1) / QPI_TRACE_CHUNK_SIZE),
+          combined(0),
+          trap(false),
+          pageBegin(nullptr),
+          pageSize(0),
+          pageCount(0),
+          dirtyCount(0) {
+        for (size_t chunk = 0; chunk < chunks.size(); chunk++) {
+            chunks[chunk] = hashChunk(chunk);
+            combined ^= chunks[chunk];
+        }
+#ifdef QPI_TRACE_POSIX
+        if (trapWrites && size > 0 && qpiTraceTrapOwner() == nullptr) {
+            startTrap();
+        }
+#else
+        (void)trapWrites;
+#endif
+        if (!trap) {
+            shadow.assign(state, state + size);
+        }
+    }
+
+    ~QpiStateHash() {
+#ifdef QPI_TRACE_POSIX
+        if (trap) {
+            mprotect(pageBegin, pageCount * pageSize, PROT_READ | PROT_WRITE);
+            qpiTraceTrapOwner() = nullptr;
+        }
+#endif
+    }
+
+    QpiStateHash(const QpiStateHash&) = delete;
+    QpiStateHash& operator=(const QpiStateHash&) = delete;
+
+    uint64 value() const {
+        return combined;
+    }
+
+    bool trapping() const {
+        return trap;
+    }
+
+    // Bring the hash up to date with the current state bytes
+    uint64 update() {
+        if (trap) {
+            updateTrapped();
+        } else {
+            updateCompared();
+        }
+        return combined;
+    }
+
+    // Full recomputation, independent of any incremental bookkeeping
+    static uint64 compute(const void* stateData, size_t stateSize) {
+        const uint8* bytes = static_cast<const uint8*>(stateData);
+        uint64 h = 0;
+        for (size_t offset = 0, chunk = 0; offset < stateSize; offset += QPI_TRACE_CHUNK_SIZE, chunk++) {
+            size_t length = stateSize - offset < QPI_TRACE_CHUNK_SIZE ? stateSize - offset : QPI_TRACE_CHUNK_SIZE;
+            h ^= qpiTraceHash(bytes + offset, length, chunk);
+        }
+        return h;
+    }
+
+private:
+#ifdef QPI_TRACE_POSIX
+    friend void qpiTraceWriteFault(int signo, siginfo_t* info, void* context);
+#endif
+
+    uint64 hashChunk(size_t chunk) const {
+        size_t offset = chunk * QPI_TRACE_CHUNK_SIZE;
+        size_t length = size - offset < QPI_TRACE_CHUNK_SIZE ? size - offset : QPI_TRACE_CHUNK_SIZE;
+        return qpiTraceHash(state + offset, length, chunk);
+    }
+
+    void rehashChunk(size_t chunk) {
+        uint64 fresh = hashChunk(chunk);
+        combined ^= chunks[chunk] ^ fresh;
+        chunks[chunk] = fresh;
+    }
+
+    void updateCompared() {
+        for (size_t chunk = 0; chunk < chunks.size(); chunk++) {
+            size_t offset = chunk * QPI_TRACE_CHUNK_SIZE;
+            size_t length = size - offset < QPI_TRACE_CHUNK_SIZE ? size - offset : QPI_TRACE_CHUNK_SIZE;
+            if (memcmp(state + offset, shadow.data() + offset, length) != 0) {
+                memcpy(shadow.data() + offset, state + offset, length);
+                rehashChunk(chunk);
+            }
+        }
+    }
+
+#ifdef QPI_TRACE_POSIX
+    void startTrap() {
+        pageSize = (size_t)sysconf(_SC_PAGESIZE);
+        uintptr_t begin = (uintptr_t)state & ~(uintptr_t)(pageSize - 1);
+        uintptr_t end = ((uintptr_t)state + size + pageSize - 1) & ~(uintptr_t)(pageSize - 1);
+        pageBegin = reinterpret_cast<uint8*>(begin);
+        pageCount = (end - begin) / pageSize;
+        dirty.assign(pageCount, 0);
+        dirtyPages.reset(new size_t[pageCount]);
+
+        struct sigaction action;
+        memset(&action, 0, sizeof(action));
+        action.sa_sigaction = qpiTraceWriteFault;
+        action.sa_flags = SA_SIGINFO;
+        sigemptyset(&action.sa_mask);
+        if (sigaction(SIGSEGV, &action, nullptr) != 0 ||
+            mprotect(pageBegin, pageCount * pageSize, PROT_READ) != 0) {
+            return;
+        }
+        qpiTraceTrapOwner() = this;
+        trap = true;
+    }
+
+    // Called from the fault handler: record the page and let the write proceed
+    bool markDirty(const void* address) {
+        const uint8* byte = static_cast<const uint8*>(address);
+        if (byte < pageBegin || byte >= pageBegin + pageCount * pageSize) {
+            return false;
+        }
+        size_t page = (size_t)(byte - pageBegin) / pageSize;
+        if (!dirty[page]) {
+            dirty[page] = 1;
+            dirtyPages[dirtyCount++] = page;
+        }
+        return mprotect(pageBegin + page * pageSize, pageSize, PROT_READ | PROT_WRITE) == 0;
+    }
+
+    void updateTrapped() {
+        for (size_t i = 0; i < dirtyCount; i++) {
+            size_t page = dirtyPages[i];
+            const uint8* first = pageBegin + page * pageSize;
+            const uint8* last = first + pageSize;
+            if (first < state) {
+                first = state;
+            }
+            if (last > state + size) {
+                last = state + size;
+            }
+            if (first < last) {
+                size_t chunkBegin = (size_t)(first - state) / QPI_TRACE_CHUNK_SIZE;
+                size_t chunkEnd = ((size_t)(last - state) + QPI_TRACE_CHUNK_SIZE - 1) / QPI_TRACE_CHUNK_SIZE;
+                for (size_t chunk = chunkBegin; chunk < chunkEnd; chunk++) {
+                    rehashChunk(chunk);
+                }
+            }
+            dirty[page] = 0;
+            mprotect(pageBegin + page * pageSize, pageSize, PROT_READ);
+        }
+        dirtyCount = 0;
+    }
+#else
+    void updateTrapped() {}
+#endif
+
+    const uint8* state;
+    size_t size;
+    std::vector<uint64> chunks;       // Hash per chunk, seeded with the chunk index
+    uint64 combined;                  // XOR of all chunk hashes
+    std::vector<uint8> shadow;        // Compare mode: state as last hashed
+
+    // Trap mode
+    bool trap;
+    uint8* pageBegin;
+    size_t pageSize;
+    size_t pageCount;
+    std::vector<uint8> dirty;
+    std::unique_ptr<size_t[]> dirtyPages;  // Sized up front: the fault handler never allocates
+    size_t dirtyCount;
+};
+
+#ifdef QPI_TRACE_POSIX
+inline void qpiTraceWriteFault(int signo, siginfo_t* info, void* context) {
+    (void)context;
+    QpiStateHash* owner = qpiTraceTrapOwner();
+    if (owner == nullptr || !owner->markDirty(info->si_addr)) {
+        signal(signo, SIG_DFL);  // Genuine crash: re-fault with the default action
+    }
+}
+#endif
+
+// ============================================================================
+// RECORDER
+// ============================================================================
+
+/*
+ * Appends records to a trace file
+ * Open it on the state to hash, then attach it to the instance with
+ * mockStartRecording(); close() patches the record count into the header.
+ */
+class QpiTraceRecorder {
+public:
+    QpiTraceRecorder() : file(nullptr), count(0) {
+        memset(&header, 0, sizeof(header));
+    }
+
+    ~QpiTraceRecorder() {
+        close();
+    }
+
+    QpiTraceRecorder(const QpiTraceRecorder&) = delete;
+    QpiTraceRecorder& operator=(const QpiTraceRecorder&) = delete;
+
+    bool open(const char* path, const void* state, size_t stateSize, bool trapWrites = false) {
+        close();
+        file = fopen(path, "wb");
+        if (file == nullptr) {
+            return false;
+        }
+        setvbuf(file, nullptr, _IOFBF, 1 << 20);
+
+        hash.reset(new QpiStateHash(state, stateSize, trapWrites));
+        memcpy(header.magic, QPI_TRACE_MAGIC, sizeof(header.magic));
+        header.version = QPI_TRACE_VERSION;
+        header.chunkSize = QPI_TRACE_CHUNK_SIZE;
+        header.stateSize = stateSize;
+        header.initialStateHash = hash->value();
+        header.recordCount = 0;
+        count = 0;
+        names.clear();
+        return fwrite(&header, sizeof(header), 1, file) == 1;
+    }
+
+    void close() {
+        if (file == nullptr) {
+            return;
+        }
+        header.recordCount = count;
+        fseek(file, 0, SEEK_SET);
+        fwrite(&header, sizeof(header), 1, file);
+        fclose(file);
+        file = nullptr;
+        hash.reset();
+    }
+
+    bool isOpen() const {
+        return file != nullptr;
+    }
+
+    uint64 records() const {
+        return count;
+    }
+
+    // One invocation, after it ran; name is null for END_TICK / END_EPOCH
+    void recordCall(QpiTraceKind kind, const char* name, const id& caller, uint32 tick, uint16 epoch,
+                    sint64 balanceBefore, const void* input, uint64 inputSize,
+                    const void* output, uint64 outputSize) {
+        QpiTraceRecord record;
+        memset(&record, 0, sizeof(record));
+        record.kind = kind;
+        record.name = name != nullptr ? intern(name, tick, epoch) : 0;
+        record.epoch = epoch;
+        record.tick = tick;
+        record.inputSize = (uint32)inputSize;
+        record.outputSize = (uint32)outputSize;
+        record.balance = balanceBefore;
+        record.caller = caller;
+        record.outputHash = outputSize > 0 ? qpiTraceHash(output, outputSize, 0) : 0;
+        record.stateHash = hash->update();
+        append(record, input);
+    }
+
+    // Ledger or owner change made by the test itself
+    void recordAccount(QpiTraceKind kind, const id& account, sint64 balance, uint32 tick, uint16 epoch) {
+        QpiTraceRecord record;
+        memset(&record, 0, sizeof(record));
+        record.kind = kind;
+        record.epoch = epoch;
+        record.tick = tick;
+        record.balance = balance;
+        record.caller = account;
+        record.stateHash = hash->update();
+        append(record, nullptr);
+    }
+
+private:
+    uint16 intern(const char* name, uint32 tick, uint16 epoch) {
+        for (size_t i = 0; i < names.size(); i++) {
+            if (names[i] == name || strcmp(names[i], name) == 0) {
+                return (uint16)i;
+            }
+        }
+        QpiTraceRecord record;
+        memset(&record, 0, sizeof(record));
+        record.kind = QPI_TRACE_NAME;
+        record.name = (uint16)names.size();
+        record.epoch = epoch;
+        record.tick = tick;
+        record.inputSize = (uint32)strlen(name);
+        record.stateHash = hash->value();
+        append(record, name);
+        names.push_back(name);
+        return record.name;
+    }
+
+    void append(const QpiTraceRecord& record, const void* payload) {
+        static const uint8 zeros[8] = { 0 };
+        fwrite(&record, sizeof(record), 1, file);
+        if (payload != nullptr && record.inputSize > 0) {
+            fwrite(payload, record.inputSize, 1, file);
+            fwrite(zeros, qpiTracePadded(record.inputSize) - record.inputSize, 1, file);
+        }
+        count++;
+    }
+
+    FILE* file;
+    QpiTraceHeader header;
+    std::unique_ptr<QpiStateHash> hash;
+    std::vector<const char*> names;   // Entry point names are string literals from the CALL_* macros
+    uint64 count;
+};
+
+// ============================================================================
+// READER
+// ============================================================================
+
+/*
+ * Read-only view of a trace file, memory-mapped where available
+ * open() validates every record and indexes them for random access.
+ */
+class QpiTraceReader {
+public:
+    QpiTraceReader() : data(nullptr), size(0), mapped(false) {}
+
+    ~QpiTraceReader() {
+        release();
+    }
+
+    QpiTraceReader(const QpiTraceReader&) = delete;
+    QpiTraceReader& operator=(const QpiTraceReader&) = delete;
+
+    bool open(const char* path, std::string& error) {
+        release();
+        if (!load(path, error)) {
+            return false;
+        }
+        if (size < sizeof(QpiTraceHeader) || memcmp(data, QPI_TRACE_MAGIC, sizeof(QPI_TRACE_MAGIC)) != 0) {
+            error = "not a QPI trace";
+            return false;
+        }
+        if (header().version != QPI_TRACE_VERSION || header().chunkSize != QPI_TRACE_CHUNK_SIZE) {
+            error = "unsupported trace version";
+            return false;
+        }
+
+        size_t offset = sizeof(QpiTraceHeader);
+        while (offset < size) {
+            if (size - offset < sizeof(QpiTraceRecord)) {
+                error = "truncated record at byte " + std::to_string(offset);
+                return false;
+            }
+            const QpiTraceRecord* record = reinterpret_cast<const QpiTraceRecord*>(data + offset);
+            uint64 length = sizeof(QpiTraceRecord) + qpiTracePadded(record->inputSize);
+            if (length > size - offset) {
+                error = "truncated payload at byte " + std::to_string(offset);
+                return false;
+            }
+            if (record->kind == QPI_TRACE_NAME) {
+                if (record->name != names.size()) {
+                    error = "name records out of order at byte " + std::to_string(offset);
+                    return false;
+                }
+                names.push_back(std::string(reinterpret_cast<const char*>(record + 1), record->inputSize));
+            } else if (record->kind == QPI_TRACE_CALL && record->name >= names.size()) {
+                error = "call to an undefined name at byte " + std::to_string(offset);
+                return false;
+            }
+            offsets.push_back(offset);
+            offset += length;
+        }
+        if (header().recordCount != 0 && header().recordCount != offsets.size()) {
+            error = "record count does not match the header";
+            return false;
+        }
+        return true;
+    }
+
+    const QpiTraceHeader& header() const {
+        return *reinterpret_cast<const QpiTraceHeader*>(data);
+    }
+
+    size_t records() const {
+        return offsets.size();
+    }
+
+    const QpiTraceRecord& record(size_t index) const {
+        return *reinterpret_cast<const QpiTraceRecord*>(data + offsets[index]);
+    }
+
+    const uint8* payload(size_t index) const {
+        return data + offsets[index] + sizeof(QpiTraceRecord);
+    }
+
+    // Byte offset of a record in the file
+    size_t offset(size_t index) const {
+        return offsets[index];
+    }
+
+    const std::string& name(uint16 index) const {
+        return names[index];
+    }
+
+    size_t nameCount() const {
+        return names.size();
+    }
+
+private:
+    bool load(const char* path, std::string& error) {
+#ifdef QPI_TRACE_POSIX
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) {
+            error = std::string("cannot open ") + path;
+            return false;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size == 0) {
+            ::close(fd);
+            error = std::string("cannot read ") + path;
+            return false;
+        }
+        void* view = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (view == MAP_FAILED) {
+            error = std::string("cannot map ") + path;
+            return false;
+        }
+        data = static_cast<const uint8*>(view);
+        size = (size_t)info.st_size;
+        mapped = true;
+        return true;
+#else
+        FILE* file = fopen(path, "rb");
+        if (file == nullptr) {
+            error = std::string("cannot open ") + path;
+            return false;
+        }
+        buffer.clear();
+        uint8 block[1 << 16];
+        size_t read;
+        while ((read = fread(block, 1, sizeof(block), file)) > 0) {
+            buffer.insert(buffer.end(), block, block + read);
+        }
+        fclose(file);
+        data = buffer.data();
+        size = buffer.size();
+        return true;
+#endif
+    }
+
+    void release() {
+#ifdef QPI_TRACE_POSIX
+        if (mapped) {
+            munmap(const_cast<uint8*>(data), size);
+        }
+#endif
+        data = nullptr;
+        size = 0;
+        mapped = false;
+        offsets.clear();
+        names.clear();
+    }
+
+    const uint8* data;
+    size_t size;
+    bool mapped;
+    std::vector<uint8> buffer;        // Copy of the file where mmap is unavailable
+    std::vector<size_t> offsets;
+    std::vector<std::string> names;
+};
+
+// ============================================================================
+// REPLAYER
+// ============================================================================
+
+struct QpiReplayResult {
+    uint64 records;              // Records replayed, including the diverging one
+    bool diverged;
+    uint64 divergedAt;           // Index of the first diverging record
+    std::string reason;
+    uint64 expectedHash;
+    uint64 actualHash;
+};
+
+/*
+ * Replays a trace against a fresh instance of a contract build
+ * Contract is the class the contract source was compiled into; its state
+ * member must be called `state`, as in every QPI contract. Entry points are
+ * resolved by the names the CALL_* macros recorded.
+ */
+template <typename Contract>
+class QpiTraceReplayer {
+public:
+    typedef void (Contract::*EntryPoint)();
+
+    struct Entry {
+        const char* name;
+        EntryPoint function;
+    };
+
+    QpiTraceReplayer(const Entry* entryTable, size_t entryCount)
+        : entries(entryTable), count(entryCount) {}
+
+    /*
+     * Construct the contract, then apply every record and compare hashes
+     * Stops at the first record whose state or output hash differs.
+     */
+    QpiReplayResult replay(Contract& contract, const QpiTraceReader& trace, bool trapWrites) const {
+        QpiReplayResult result;
+        result.records = 0;
+        result.diverged = false;
+        result.divergedAt = 0;
+        result.expectedHash = 0;
+        result.actualHash = 0;
+
+        if (trace.header().stateSize != sizeof(contract.state)) {
+            result.diverged = true;
+            result.reason = "state size differs: recorded " + std::to_string(trace.header().stateSize) +
+                            " bytes, this build has " + std::to_string(sizeof(contract.state));
+            return result;
+        }
+
+        contract.contractConstructor();
+        QpiStateHash hash(&contract.state, sizeof(contract.state), trapWrites);
+        if (hash.value() != trace.header().initialStateHash) {
+            result.diverged = true;
+            result.reason = "initial state differs (recording did not start from a freshly constructed contract)";
+            result.expectedHash = trace.header().initialStateHash;
+            result.actualHash = hash.value();
+            return result;
+        }
+
+        std::vector<EntryPoint> resolved(trace.nameCount(), nullptr);
+        std::vector<uint8> output;
+
+        for (size_t i = 0; i < trace.records(); i++) {
+            const QpiTraceRecord& record = trace.record(i);
+            result.records++;
+            contract.mockCurrentTick = record.tick;
+            contract.mockCurrentEpoch = record.epoch;
+
+            uint64 outputHash = 0;
+            switch (record.kind) {
+            case QPI_TRACE_NAME:
+                resolved[record.name] = resolve(trace.name(record.name));
+                break;
+            case QPI_TRACE_CALL:
+                if (resolved[record.name] == nullptr) {
+                    return diverge(result, i, "entry point '" + trace.name(record.name) + "' is not in this build");
+                }
+                if (output.size() < record.outputSize) {
+                    output.resize(record.outputSize);
+                }
+                contract.mockSetCaller(record.caller);
+                contract.mockContractBalance = record.balance;
+                contract.mockBeginCall(trace.payload(i), record.inputSize,
+                                       record.outputSize > 0 ? output.data() : nullptr, record.outputSize);
+                (contract.*resolved[record.name])();
+                contract.mockEndCall();
+                outputHash = record.outputSize > 0 ? qpiTraceHash(output.data(), record.outputSize, 0) : 0;
+                break;
+            case QPI_TRACE_END_TICK:
+                contract.mockContractBalance = record.balance;
+                contract.contractEndTick();
+                break;
+            case QPI_TRACE_END_EPOCH:
+                contract.mockContractBalance = record.balance;
+                contract.contractEndEpoch();
+                break;
+            case QPI_TRACE_SET_BALANCE:
+                contract.mockSetBalance(record.caller, record.balance);
+                break;
+            case QPI_TRACE_SET_OWNER:
+                contract.mockSetOwner(record.caller);
+                break;
+            default:
+                return diverge(result, i, "unknown record kind " + std::to_string(record.kind));
+            }
+
+            uint64 stateHash = hash.update();
+            if (stateHash != record.stateHash) {
+                result.expectedHash = record.stateHash;
+                result.actualHash = stateHash;
+                return diverge(result, i, "state hash differs");
+            }
+            if (outputHash != record.outputHash) {
+                result.expectedHash = record.outputHash;
+                result.actualHash = outputHash;
+                return diverge(result, i, "output differs");
+            }
+        }
+        return result;
+    }
+
+private:
+    EntryPoint resolve(const std::string& name) const {
+        for (size_t i = 0; i < count; i++) {
+            if (name == entries[i].name) {
+                return entries[i].function;
+            }
+        }
+        return nullptr;
+    }
+
+    static QpiReplayResult& diverge(QpiReplayResult& result, size_t index, const std::string& reason) {
+        result.diverged = true;
+        result.divergedAt = index;
+        result.reason = reason;
+        return result;
+    }
+
+    const Entry* entries;
+    size_t count;
+};
+
+#endif // QPI_TRACE_H